@@ -0,0 +1,471 @@
+//--------------------------------------------------------------
+// Logger library
+//--------------------------------------------------------------
+#include "Logger.hpp"
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <latch>
+#include <map>
+#include <new>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+//--------------------------------------------------------------
+// **Throughput and per-call latency of the LOG_* paths, written as JSON for regression tracking**
+//
+//  logger_bench [--threads N] [--calls N] [--mode sync|async|deferred|all]
+//               [--output <log destination>] [--json <result file>]
+//
+// Console output of the logger goes to --output (the null device by default) so the terminal
+// does not dominate the measurement; a summary table is printed on stderr.
+//
+// The run ends with an allocation check: after a warm-up, LOG_* calls must not reach operator new
+// in any thread, otherwise the benchmark exits with status 2.
+//--------------------------------------------------------------
+namespace {
+    //--------------------------------------------------------------
+    std::atomic<uint64_t> s_allocations{0};
+    //--------------------------------------------------------------
+    void* counted_allocate(const size_t& size) {
+        s_allocations.fetch_add(1UL, std::memory_order_relaxed);
+        return std::malloc(size ? size : 1UL);
+    } // end void* counted_allocate(const size_t& size)
+} // end namespace
+//--------------------------------------------------------------
+// **Every allocation of the process goes through the counter**
+//--------------------------------------------------------------
+void* operator new(size_t size) {
+    if (void* _memory = counted_allocate(size)) {
+        return _memory;
+    } // end if (void* _memory = counted_allocate(size))
+    throw std::bad_alloc();
+} // end void* operator new(size_t size)
+//--------------------------------------------------------------
+void* operator new[](size_t size) {
+    return operator new(size);
+} // end void* operator new[](size_t size)
+//--------------------------------------------------------------
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return counted_allocate(size);
+} // end void* operator new(size_t size, const std::nothrow_t&) noexcept
+//--------------------------------------------------------------
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return counted_allocate(size);
+} // end void* operator new[](size_t size, const std::nothrow_t&) noexcept
+//--------------------------------------------------------------
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+} // end void operator delete(void* memory) noexcept
+//--------------------------------------------------------------
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+} // end void operator delete[](void* memory) noexcept
+//--------------------------------------------------------------
+void operator delete(void* memory, size_t) noexcept {
+    std::free(memory);
+} // end void operator delete(void* memory, size_t) noexcept
+//--------------------------------------------------------------
+void operator delete[](void* memory, size_t) noexcept {
+    std::free(memory);
+} // end void operator delete[](void* memory, size_t) noexcept
+//--------------------------------------------------------------
+namespace {
+    //--------------------------------------------------------------
+    using Clock = std::chrono::steady_clock;
+    //--------------------------------------------------------------
+#if defined(_WIN32)
+    constexpr const char* NULL_DEVICE = "NUL";
+#else
+    constexpr const char* NULL_DEVICE = "/dev/null";
+#endif
+    //--------------------------------------------------------------
+    enum class Mode { SYNC, ASYNC, DEFERRED };
+    //--------------------------------------------------------------
+    constexpr std::string_view mode_name(const Mode& mode) {
+        switch (mode) {
+            case Mode::SYNC:        return "sync";
+            case Mode::ASYNC:       return "async";
+            case Mode::DEFERRED:    return "deferred";
+        } // end switch (mode)
+        return "";
+    } // end constexpr std::string_view mode_name(const Mode& mode)
+    //--------------------------------------------------------------
+    struct Options {
+        size_t max_threads      = std::max(4U, std::thread::hardware_concurrency());
+        size_t calls            = 20000UL; // Per producer thread
+        std::vector<Mode> modes = {Mode::SYNC, Mode::ASYNC, Mode::DEFERRED};
+        std::string output      = NULL_DEVICE;
+        std::string json        = "logger_bench.json";
+    }; // end struct Options
+    //--------------------------------------------------------------
+    struct Result {
+        std::string scenario;
+        std::string variant;
+        Mode mode;
+        size_t threads;
+        size_t calls;
+        double call_seconds;    // Until the last producer returned
+        double total_seconds;   // Until everything was written
+        uint64_t p50;
+        uint64_t p99;
+        uint64_t p999;
+        uint64_t max;
+    }; // end struct Result
+    //--------------------------------------------------------------
+    struct AllocationResult {
+        Mode mode;
+        size_t calls;       // Iterations, each logging two to four records
+        uint64_t allocations;
+    }; // end struct AllocationResult
+    //--------------------------------------------------------------
+    void set_mode(const Mode& mode) {
+        //--------------------------
+        Logger::Logger& _logger = Logger::Logger::instance();
+        //--------------------------
+        _logger.stop_async();
+        _logger.set_deferred_formatting(mode == Mode::DEFERRED);
+        if (mode != Mode::SYNC) {
+            _logger.start_async();
+        } // end if (mode != Mode::SYNC)
+        //--------------------------
+    } // end void set_mode(const Mode& mode)
+    //--------------------------------------------------------------
+    uint64_t percentile(const std::vector<uint32_t>& sorted, const double& fraction) {
+        //--------------------------
+        if (sorted.empty()) {
+            return 0UL;
+        } // end if (sorted.empty())
+        //--------------------------
+        const size_t _index = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1UL) + 0.5);
+        return sorted[std::min(_index, sorted.size() - 1UL)];
+        //--------------------------
+    } // end uint64_t percentile(const std::vector<uint32_t>& sorted, const double& fraction)
+    //--------------------------------------------------------------
+    // **Runs call(thread, i) calls times on each of threads producers and times every call**
+    //--------------------------------------------------------------
+    Result run(std::string scenario, std::string variant, const Mode& mode, const size_t& threads, const size_t& calls,
+               const std::function<void(size_t, size_t)>& call) {
+        //--------------------------
+        set_mode(mode);
+        //--------------------------
+        std::vector<std::vector<uint32_t>> _latencies(threads, std::vector<uint32_t>(calls));
+        std::vector<std::thread> _producers;
+        std::latch _start(static_cast<std::ptrdiff_t>(threads) + 1);
+        //--------------------------
+        for (size_t t = 0; t < threads; ++t) {
+            _producers.emplace_back([&, t] {
+                //--------------------------
+                std::vector<uint32_t>& _samples = _latencies[t];
+                _start.arrive_and_wait();
+                //--------------------------
+                for (size_t i = 0; i < calls; ++i) {
+                    const auto _before = Clock::now();
+                    call(t, i);
+                    const auto _after = Clock::now();
+                    _samples[i] = static_cast<uint32_t>(std::min<int64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(_after - _before).count(), UINT32_MAX));
+                } // end for (size_t i = 0; i < calls; ++i)
+                //--------------------------
+            });
+        } // end for (size_t t = 0; t < threads; ++t)
+        //--------------------------
+        const auto _begin = Clock::now();
+        _start.arrive_and_wait();
+        //--------------------------
+        for (auto& _producer : _producers) {
+            _producer.join();
+        } // end for (auto& _producer : _producers)
+        //--------------------------
+        const auto _called = Clock::now();
+        Logger::Logger::instance().flush();
+        const auto _end = Clock::now();
+        //--------------------------
+        std::vector<uint32_t> _all;
+        _all.reserve(threads * calls);
+        for (const auto& _samples : _latencies) {
+            _all.insert(_all.end(), _samples.begin(), _samples.end());
+        } // end for (const auto& _samples : _latencies)
+        std::sort(_all.begin(), _all.end());
+        //--------------------------
+        return Result{std::move(scenario), std::move(variant), mode, threads, threads * calls,
+                      std::chrono::duration<double>(_called - _begin).count(),
+                      std::chrono::duration<double>(_end - _begin).count(),
+                      percentile(_all, 0.50), percentile(_all, 0.99), percentile(_all, 0.999),
+                      _all.empty() ? 0UL : _all.back()};
+        //--------------------------
+    } // end Result run(...)
+    //--------------------------------------------------------------
+    std::string escape(std::string_view text) {
+        //--------------------------
+        std::string _escaped;
+        for (const char c : text) {
+            if (c == '"' || c == '\\') {
+                _escaped.push_back('\\');
+            } // end if (c == '"' || c == '\\')
+            _escaped.push_back(c);
+        } // end for (const char c : text)
+        //--------------------------
+        return _escaped;
+        //--------------------------
+    } // end std::string escape(std::string_view text)
+    //--------------------------------------------------------------
+    void write_json(std::ostream& output, const Options& options, const std::vector<Result>& results,
+                    const std::vector<AllocationResult>& allocations) {
+        //--------------------------
+        output << "{\n"
+               << "  \"timestamp\": " << std::time(nullptr) << ",\n"
+               << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n"
+               << "  \"calls_per_thread\": " << options.calls << ",\n"
+               << "  \"results\": [\n";
+        //--------------------------
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Result& _result = results[i];
+            output << "    {\"scenario\": \"" << escape(_result.scenario) << "\""
+                   << ", \"variant\": \"" << escape(_result.variant) << "\""
+                   << ", \"mode\": \"" << mode_name(_result.mode) << "\""
+                   << ", \"threads\": " << _result.threads
+                   << ", \"calls\": " << _result.calls
+                   << ", \"call_seconds\": " << _result.call_seconds
+                   << ", \"total_seconds\": " << _result.total_seconds
+                   << ", \"calls_per_second\": " << static_cast<double>(_result.calls) / _result.call_seconds
+                   << ", \"written_per_second\": " << static_cast<double>(_result.calls) / _result.total_seconds
+                   << ", \"latency_ns\": {\"p50\": " << _result.p50 << ", \"p99\": " << _result.p99
+                   << ", \"p999\": " << _result.p999 << ", \"max\": " << _result.max << "}}"
+                   << (i + 1 < results.size() ? ",\n" : "\n");
+        } // end for (size_t i = 0; i < results.size(); ++i)
+        //--------------------------
+        output << "  ],\n"
+               << "  \"allocations\": [\n";
+        //--------------------------
+        for (size_t i = 0; i < allocations.size(); ++i) {
+            const AllocationResult& _result = allocations[i];
+            output << "    {\"mode\": \"" << mode_name(_result.mode) << "\""
+                   << ", \"calls\": " << _result.calls
+                   << ", \"allocations\": " << _result.allocations << "}"
+                   << (i + 1 < allocations.size() ? ",\n" : "\n");
+        } // end for (size_t i = 0; i < allocations.size(); ++i)
+        //--------------------------
+        output << "  ]\n}\n";
+        //--------------------------
+    } // end void write_json(...)
+    //--------------------------------------------------------------
+    void print_result(const Result& result) {
+        std::fprintf(stderr, "%-10s %-20s %-9s %3zu  %12.0f %12.0f  %8llu %8llu %8llu %10llu\n",
+                     result.scenario.c_str(), result.variant.c_str(), std::string(mode_name(result.mode)).c_str(),
+                     result.threads,
+                     static_cast<double>(result.calls) / result.call_seconds,
+                     static_cast<double>(result.calls) / result.total_seconds,
+                     static_cast<unsigned long long>(result.p50), static_cast<unsigned long long>(result.p99),
+                     static_cast<unsigned long long>(result.p999), static_cast<unsigned long long>(result.max));
+    } // end void print_result(const Result& result)
+    //--------------------------------------------------------------
+    // **Counts operator new calls of a warmed-up logger over calls iterations of a few typical sites**
+    //--------------------------------------------------------------
+    AllocationResult check_allocations(const Mode& mode, const size_t& calls) {
+        //--------------------------
+        set_mode(mode);
+        //--------------------------
+        const std::string _text = "a std::string argument";
+        const auto _call = [&_text](size_t i) {
+            LOG_INFO("iteration {} value {:.3f} text {}", i, 0.5 * static_cast<double>(i), _text);
+            LOG_INFO("a message without arguments");
+            if (i % 64UL == 0UL) {
+                LOG_WARNING("warning {} {}", i, 'w');
+                LOG_ERROR("error {} {}", i, true);
+            } // end if (i % 64UL == 0UL)
+        };
+        //--------------------------
+        // Warm-up: thread-local buffers, the producer ring and the writer's strings reach their capacity
+        for (size_t i = 0; i < calls; ++i) {
+            _call(i);
+        } // end for (size_t i = 0; i < calls; ++i)
+        Logger::Logger::instance().flush();
+        //--------------------------
+        const uint64_t _before = s_allocations.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < calls; ++i) {
+            _call(i);
+        } // end for (size_t i = 0; i < calls; ++i)
+        Logger::Logger::instance().flush();
+        const uint64_t _after = s_allocations.load(std::memory_order_relaxed);
+        //--------------------------
+        return AllocationResult{mode, calls, _after - _before};
+        //--------------------------
+    } // end AllocationResult check_allocations(const Mode& mode, const size_t& calls)
+    //--------------------------------------------------------------
+    bool parse_options(int argc, char* argv[], Options& options) {
+        //--------------------------
+        for (int i = 1; i < argc; ++i) {
+            //--------------------------
+            const std::string_view _argument(argv[i]);
+            if (i + 1 >= argc) {
+                return false;
+            } // end if (i + 1 >= argc)
+            const std::string _value(argv[++i]);
+            //--------------------------
+            if (_argument == "--threads") {
+                options.max_threads = std::max(1UL, std::stoul(_value));
+            } else if (_argument == "--calls") {
+                options.calls = std::max(1UL, std::stoul(_value));
+            } else if (_argument == "--output") {
+                options.output = _value;
+            } else if (_argument == "--json") {
+                options.json = _value;
+            } else if (_argument == "--mode") {
+                if (_value == "sync") {
+                    options.modes = {Mode::SYNC};
+                } else if (_value == "async") {
+                    options.modes = {Mode::ASYNC};
+                } else if (_value == "deferred") {
+                    options.modes = {Mode::DEFERRED};
+                } else if (_value != "all") {
+                    return false;
+                } // end if (_value == "sync")
+            } else {
+                return false;
+            } // end if (_argument == "--threads")
+            //--------------------------
+        } // end for (int i = 1; i < argc; ++i)
+        //--------------------------
+        return true;
+        //--------------------------
+    } // end bool parse_options(int argc, char* argv[], Options& options)
+    //--------------------------------------------------------------
+} // end namespace
+//--------------------------------------------------------------
+int main(int argc, char* argv[]) {
+    //--------------------------
+    Options _options;
+    try {
+        if (!parse_options(argc, argv, _options)) {
+            std::cerr << "Usage: " << argv[0] << " [--threads N] [--calls N] [--mode sync|async|deferred|all]"
+                      << " [--output <log destination>] [--json <result file>]\n";
+            return 1;
+        } // end if (!parse_options(argc, argv, _options))
+    } catch (const std::exception&) {
+        std::cerr << argv[0] << ": invalid number\n";
+        return 1;
+    } // end try
+    //--------------------------
+    if (!std::freopen(_options.output.c_str(), "w", stdout)) {
+        std::cerr << _options.output << ": cannot open for writing\n";
+        return 1;
+    } // end if (!std::freopen(_options.output.c_str(), "w", stdout))
+    //--------------------------
+    std::vector<Result> _results;
+    const auto _record = [&_results](Result result) {
+        print_result(result);
+        _results.push_back(std::move(result));
+    };
+    //--------------------------
+    std::fprintf(stderr, "%-10s %-20s %-9s %3s  %12s %12s  %8s %8s %8s %10s\n",
+                 "scenario", "variant", "mode", "thr", "calls/s", "written/s", "p50 ns", "p99 ns", "p99.9 ns", "max ns");
+    //--------------------------
+    const size_t _calls = _options.calls;
+    const std::vector<int> _vector(16);
+    const std::vector<int> _large(100000UL);
+    const std::map<std::string, int> _map = {{"alpha", 1}, {"beta", 2}, {"gamma", 3}, {"delta", 4}};
+    //--------------------------
+    for (const Mode& _mode : _options.modes) {
+        //--------------------------
+        // Producer-count sweep
+        for (size_t _threads = 1; _threads <= _options.max_threads; _threads *= 2) {
+            _record(run("threads", "int+double", _mode, _threads, _calls, [](size_t thread, size_t i) {
+                LOG_INFO("thread {} iteration {} value {}", thread, i, 0.5 * static_cast<double>(i));
+            }));
+        } // end for (size_t _threads = 1; _threads <= _options.max_threads; _threads *= 2)
+        //--------------------------
+        // Message-size sweep
+        for (const size_t _size : {16UL, 64UL, 256UL, 1024UL}) {
+            const std::string _payload(_size, 'x');
+            _record(run("size", std::to_string(_size) + " bytes", _mode, 1UL, _calls, [&_payload](size_t, size_t) {
+                LOG_INFO("{}", _payload);
+            }));
+        } // end for (const size_t _size : {16UL, 64UL, 256UL, 1024UL})
+        //--------------------------
+        // Argument-type sweep
+        const std::string _text = "a std::string argument";
+        _record(run("arguments", "none", _mode, 1UL, _calls, [](size_t, size_t) {
+            LOG_INFO("a message without arguments");
+        }));
+        _record(run("arguments", "int", _mode, 1UL, _calls, [](size_t, size_t i) {
+            LOG_INFO("integer {}", i);
+        }));
+        _record(run("arguments", "double", _mode, 1UL, _calls, [](size_t, size_t i) {
+            LOG_INFO("double {:.3f}", static_cast<double>(i) / 7.0);
+        }));
+        _record(run("arguments", "const char*", _mode, 1UL, _calls, [](size_t, size_t) {
+            LOG_INFO("literal {}", "a string literal argument");
+        }));
+        _record(run("arguments", "std::string", _mode, 1UL, _calls, [&_text](size_t, size_t) {
+            LOG_INFO("string {}", _text);
+        }));
+        _record(run("arguments", "mixed x6", _mode, 1UL, _calls, [&_text](size_t, size_t i) {
+            LOG_INFO("{} {} {} {} {} {}", i, -1, 2.5, 'c', true, _text);
+        }));
+        //--------------------------
+        // Containers through *_STREAM
+        _record(run("stream", "vector<int>[16]", _mode, 1UL, _calls, [&_vector](size_t, size_t) {
+            LOG_INFO_STREAM("vector:", _vector);
+        }));
+        _record(run("stream", "map<string,int>[4]", _mode, 1UL, _calls, [&_map](size_t, size_t) {
+            LOG_INFO_STREAM("map:", _map);
+        }));
+        _record(run("stream", "vector<int>[100k]", _mode, 1UL, std::max(1UL, _calls / 100UL), [&_large](size_t, size_t) {
+            LOG_INFO_STREAM("capped vector:", _large);
+        }));
+        //--------------------------
+        // *_ONCE: every call after the first only tests the per-site flag
+        _record(run("once", "LOG_INFO_ONCE", _mode, 1UL, _calls, [](size_t, size_t) {
+            LOG_INFO_ONCE("logged a single time");
+        }));
+        //--------------------------
+        // Rate-limited sites: almost every call is suppressed before its arguments are evaluated
+        _record(run("limited", "LOG_INFO_EVERY_N", _mode, 1UL, _calls, [](size_t, size_t i) {
+            LOG_INFO_EVERY_N(1000, "sampled iteration {}", i);
+        }));
+        _record(run("limited", "LOG_INFO_RATE", _mode, 1UL, _calls, [](size_t, size_t i) {
+            LOG_INFO_RATE(100, 10, "rate-limited iteration {}", i);
+        }));
+        //--------------------------
+    } // end for (const Mode& _mode : _options.modes)
+    //--------------------------
+    // Steady-state allocation check
+    std::vector<AllocationResult> _allocations;
+    bool _allocation_free = true;
+    std::fprintf(stderr, "\n%-10s %-9s %10s %12s\n", "check", "mode", "calls", "allocations");
+    for (const Mode& _mode : _options.modes) {
+        _allocations.push_back(check_allocations(_mode, _calls));
+        std::fprintf(stderr, "%-10s %-9s %10zu %12llu\n", "alloc", std::string(mode_name(_mode)).c_str(),
+                     _allocations.back().calls, static_cast<unsigned long long>(_allocations.back().allocations));
+        _allocation_free = _allocation_free && _allocations.back().allocations == 0UL;
+    } // end for (const Mode& _mode : _options.modes)
+    //--------------------------
+    Logger::Logger::instance().stop_async();
+    //--------------------------
+    std::ofstream _json(_options.json);
+    if (!_json) {
+        std::cerr << _options.json << ": cannot open for writing\n";
+        return 1;
+    } // end if (!_json)
+    write_json(_json, _options, _results, _allocations);
+    //--------------------------
+    if (!_allocation_free) {
+        std::cerr << argv[0] << ": the logging hot path allocated after warm-up\n";
+        return 2;
+    } // end if (!_allocation_free)
+    //--------------------------
+    return 0;
+    //--------------------------
+} // end int main(int argc, char* argv[])
+//--------------------------------------------------------------
@@ -2,6 +2,8 @@
 // Main Header 
 //--------------------------------------------------------------
 #include "Logger.hpp"
+#include "AsyncSink.hpp"
+#include "ChromeTraceSink.hpp"
 //--------------------------------------------------------------
 // Standard cpp library
 //--------------------------------------------------------------
@@ -129,13 +131,72 @@ void measureLoggingOverheadOnce(void) {
     //--------------------------
 } // end void measureLoggingOverheadOnce(void)
 //--------------------------------------------------------------
+void measureLoggingOverheadAsync(void) {
+    const int iterations = 1000;
+    Logger::Logger::instance().start_async();
+    auto start = std::chrono::high_resolution_clock::now();
+    //--------------------------
+    for (int i = 0; i < iterations; ++i) {
+        LOG_INFO("Async logging overhead test: iteration {}", i);
+    } // end for(int i = 0; i < iterations; ++i)
+    //--------------------------
+    auto end = std::chrono::high_resolution_clock::now();
+    Logger::Logger::instance().flush();
+    std::chrono::duration<double, std::micro> duration = end - start;
+    std::cout << "Total time taken for " << iterations << " async logging operations: " 
+              << duration.count() << " microseconds\n";
+    std::cout << "Average time per async logging operation: " 
+              << duration.count() / iterations << " microseconds\n";
+    //--------------------------
+    Logger::Logger::instance().stop_async();
+    //--------------------------
+} // end void measureLoggingOverheadAsync(void)
+//--------------------------------------------------------------
+void traceLoggingOverhead(void) {
+    const int iterations = 1000;
+    //--------------------------
+    // Scopes go to trace.json only, open it in chrome://tracing or ui.perfetto.dev.
+    // The trace file is written on a thread of its own, off the logger's writer.
+    Logger::SinkOptions trace;
+    trace.levels = 0;
+    Logger::Logger::instance().add_sink(std::make_shared<Logger::AsyncSink>(std::make_shared<Logger::ChromeTraceSink>("trace.json")), trace);
+    Logger::Logger::instance().set_tracing(Logger::TraceOptions());
+    //--------------------------
+    {
+        LOG_SCOPE_TIMER("logging loop");
+        for (int i = 0; i < iterations; ++i) {
+            LOG_SCOPE_TIMER("LOG_INFO");
+            LOG_INFO("Traced logging overhead test: iteration {}", i);
+        } // end for(int i = 0; i < iterations; ++i)
+    }
+    //--------------------------
+    Logger::Logger::instance().flush();
+    //--------------------------
+} // end void traceLoggingOverhead(void)
+//--------------------------------------------------------------
+void printLoggerMetrics(void) {
+    const Logger::MetricsSnapshot metrics = Logger::Logger::instance().metrics();
+    //--------------------------
+    std::cout << "Log calls measured by the logger: " << metrics.calls() << "\n";
+    std::cout << "Average time per call seen by the logger: "
+              << (metrics.calls() ? metrics.latency_nanoseconds / metrics.calls() : 0) << " nanoseconds\n";
+    std::cout << "Contended write lock acquisitions: " << metrics.lock_waits << "\n";
+    for (const Logger::SinkMetrics& sink : metrics.sinks) {
+        std::cout << "Sink " << sink.name << ": " << sink.writes << " writes, "
+                  << sink.write_nanoseconds / 1000 << " microseconds\n";
+    } // end for (const Logger::SinkMetrics& sink : metrics.sinks)
+    //--------------------------
+} // end void printLoggerMetrics(void)
+//--------------------------------------------------------------
 int main(void) {
     //--------------------------
     // Example logging usage
     //--------------------------
     exampleLogging();
     //--------------------------
-    // Measure the logging overhead
+    // Measure the logging overhead, also as seen by the logger itself
+    //--------------------------
+    Logger::Logger::instance().set_metrics(Logger::MetricsOptions());
     //--------------------------
     measureLoggingOverhead();
     //--------------------------
@@ -143,6 +204,12 @@ int main(void) {
     //--------------------------
     measureLoggingOverheadOnce();
     //--------------------------
+    measureLoggingOverheadAsync();
+    //--------------------------
+    traceLoggingOverhead();
+    //--------------------------
+    printLoggerMetrics();
+    //--------------------------
     return 0;
     //--------------------------
 } // end int main(void)
@@ -0,0 +1,211 @@
+#pragma once
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <type_traits>
+//--------------------------------------------------------------
+// **True only for a string literal, the compiler folds it before any argument is evaluated**
+// Without the builtin every format is formatted eagerly.
+//--------------------------------------------------------------
+#if defined(__GNUC__) || defined(__clang__)
+    #define LOGGER_IS_LITERAL(text) __builtin_constant_p(text)
+#else
+    #define LOGGER_IS_LITERAL(text) false
+#endif
+#define LOGGER_FORMAT(text) Logger::FormatString(text, LOGGER_IS_LITERAL(text))
+//--------------------------------------------------------------
+namespace Logger {
+    //--------------------------------------------------------------
+    // **Format string that remembers whether it refers to a string literal**
+    // Only literals live long enough to be formatted later by the writer thread. A char array
+    // may be a stack buffer, so it counts as a literal only when the LOG_* macros prove it
+    // through LOGGER_IS_LITERAL; everything else is formatted on the calling thread.
+    // The implicit conversion at the call site also records its source location.
+    //--------------------------------------------------------------
+    class FormatString {
+        //--------------------------------------------------------------
+        public:
+            //--------------------------------------------------------------
+            template<typename T, typename = std::enable_if_t<std::is_convertible_v<const T&, std::string_view>>>
+            constexpr FormatString(const T& text, const std::source_location& location = std::source_location::current()) :
+                m_text(text), m_static(false), m_location(location) {
+                //--------------------------
+            } // end constexpr FormatString(const T& text, const std::source_location& location)
+            //--------------------------
+            // **literal must only be true for a string literal, see LOGGER_FORMAT**
+            template<size_t N>
+            constexpr FormatString(const char (&text)[N], const bool& literal, const std::source_location& location = std::source_location::current()) :
+                m_text(text), m_static(literal), m_location(location) {
+                //--------------------------
+            } // end constexpr FormatString(const char (&text)[N], const bool& literal, const std::source_location& location)
+            //--------------------------
+            template<typename T, typename = std::enable_if_t<std::is_convertible_v<const T&, std::string_view> && !std::is_array_v<T>>>
+            constexpr FormatString(const T& text, const bool&, const std::source_location& location = std::source_location::current()) :
+                m_text(text), m_static(false), m_location(location) {
+                //--------------------------
+            } // end constexpr FormatString(const T& text, const bool&, const std::source_location& location)
+            //--------------------------
+            constexpr std::string_view view(void) const {
+                return m_text;
+            } // end constexpr std::string_view view(void) const
+            //--------------------------
+            constexpr bool is_static(void) const {
+                return m_static;
+            } // end constexpr bool is_static(void) const
+            //--------------------------
+            constexpr const std::source_location& location(void) const {
+                return m_location;
+            } // end constexpr const std::source_location& location(void) const
+            //--------------------------------------------------------------
+        private:
+            //--------------------------------------------------------------
+            std::string_view m_text;
+            bool m_static;
+            std::source_location m_location;
+        //--------------------------------------------------------------
+    }; // end class FormatString
+    //--------------------------------------------------------------
+    enum class ArgumentType : uint8_t {
+        BOOL    = 0,
+        CHAR    = 1,
+        INT64   = 2,
+        UINT64  = 3,
+        FLOAT   = 4,
+        DOUBLE  = 5,
+        POINTER = 6,
+        STRING  = 7
+    }; // end enum class ArgumentType : uint8_t
+    //--------------------------------------------------------------
+    // **Raw argument bytes: a type tag per argument followed by its value,
+    // strings are stored inline as a 32-bit length and the characters**
+    //--------------------------------------------------------------
+    struct CapturedArguments {
+        static constexpr size_t CAPACITY = 192UL;
+        //--------------------------
+        std::array<std::byte, CAPACITY> data;
+        uint16_t size   = 0U;
+        uint8_t count   = 0U;
+    }; // end struct CapturedArguments
+    //--------------------------------------------------------------
+    namespace detail {
+        //--------------------------------------------------------------
+        template<typename T>
+        struct is_string_argument : std::bool_constant<
+            std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> ||
+            std::is_same_v<T, const char*>  || std::is_same_v<T, char*> ||
+            (std::is_array_v<T> && std::is_same_v<std::remove_cv_t<std::remove_extent_t<T>>, char>)> {};
+        //--------------------------
+        template<typename T>
+        struct is_capturable : std::bool_constant<
+            std::is_arithmetic_v<T> && !std::is_same_v<T, long double> &&
+            !std::is_same_v<T, wchar_t> && !std::is_same_v<T, char8_t> &&
+            !std::is_same_v<T, char16_t> && !std::is_same_v<T, char32_t>> {};
+        //--------------------------
+        template<typename T>
+        constexpr ArgumentType argument_type(void) {
+            if constexpr (std::is_same_v<T, bool>) {
+                return ArgumentType::BOOL;
+            } else if constexpr (std::is_same_v<T, char>) {
+                return ArgumentType::CHAR;
+            } else if constexpr (std::is_same_v<T, float>) {
+                return ArgumentType::FLOAT;
+            } else if constexpr (std::is_floating_point_v<T>) {
+                return ArgumentType::DOUBLE;
+            } else if constexpr (std::is_signed_v<T>) {
+                return ArgumentType::INT64;
+            } else {
+                return ArgumentType::UINT64;
+            } // end if constexpr (std::is_same_v<T, bool>)
+        } // end constexpr ArgumentType argument_type(void)
+        //--------------------------
+        inline bool put(CapturedArguments& arguments, const void* source, const size_t& size) {
+            //--------------------------
+            if (arguments.size + size > CapturedArguments::CAPACITY) {
+                return false;
+            } // end if (arguments.size + size > CapturedArguments::CAPACITY)
+            //--------------------------
+            std::memcpy(arguments.data.data() + arguments.size, source, size);
+            arguments.size = static_cast<uint16_t>(arguments.size + size);
+            //--------------------------
+            return true;
+            //--------------------------
+        } // end inline bool put(CapturedArguments& arguments, const void* source, const size_t& size)
+        //--------------------------
+        inline bool put_string(CapturedArguments& arguments, std::string_view text) {
+            //--------------------------
+            const auto _type    = ArgumentType::STRING;
+            const auto _length  = static_cast<uint32_t>(text.size());
+            //--------------------------
+            return put(arguments, &_type, sizeof(_type)) && put(arguments, &_length, sizeof(_length)) &&
+                   put(arguments, text.data(), text.size());
+            //--------------------------
+        } // end inline bool put_string(CapturedArguments& arguments, std::string_view text)
+        //--------------------------
+        template<typename T>
+        bool put_argument(CapturedArguments& arguments, const T& value) {
+            //--------------------------
+            using Type = std::remove_cv_t<T>;
+            //--------------------------
+            if constexpr (is_string_argument<Type>::value) {
+                if constexpr (std::is_pointer_v<Type>) {
+                    if (!value) {
+                        return false; // Let the eager path report the null string
+                    } // end if (!value)
+                } // end if constexpr (std::is_pointer_v<Type>)
+                return put_string(arguments, std::string_view(value));
+            } else if constexpr (std::is_same_v<Type, void*> || std::is_same_v<Type, const void*>) {
+                const auto _type    = ArgumentType::POINTER;
+                const auto _value   = reinterpret_cast<uintptr_t>(value);
+                return put(arguments, &_type, sizeof(_type)) && put(arguments, &_value, sizeof(_value));
+            } else {
+                constexpr ArgumentType _type = argument_type<Type>();
+                if constexpr (_type == ArgumentType::INT64) {
+                    const auto _value = static_cast<int64_t>(value);
+                    return put(arguments, &_type, sizeof(_type)) && put(arguments, &_value, sizeof(_value));
+                } else if constexpr (_type == ArgumentType::UINT64) {
+                    const auto _value = static_cast<uint64_t>(value);
+                    return put(arguments, &_type, sizeof(_type)) && put(arguments, &_value, sizeof(_value));
+                } else {
+                    return put(arguments, &_type, sizeof(_type)) && put(arguments, &value, sizeof(value));
+                } // end if constexpr (_type == ArgumentType::INT64)
+            } // end if constexpr (is_string_argument<Type>::value)
+            //--------------------------
+        } // end bool put_argument(CapturedArguments& arguments, const T& value)
+        //--------------------------------------------------------------
+    } // end namespace detail
+    //--------------------------------------------------------------
+    template<typename T>
+    inline constexpr bool is_capturable_v = detail::is_string_argument<std::remove_cv_t<std::remove_reference_t<T>>>::value ||
+                                            detail::is_capturable<std::remove_cv_t<std::remove_reference_t<T>>>::value ||
+                                            std::is_same_v<std::remove_cv_t<std::remove_reference_t<T>>, void*> ||
+                                            std::is_same_v<std::remove_cv_t<std::remove_reference_t<T>>, const void*>;
+    //--------------------------------------------------------------
+    // **Copies the arguments into the record, false when they do not fit**
+    //--------------------------------------------------------------
+    template<typename... Args>
+    bool capture(CapturedArguments& arguments, const Args&... args) {
+        //--------------------------
+        static_assert((is_capturable_v<Args> && ...), "Argument type cannot be captured");
+        //--------------------------
+        arguments.size  = 0U;
+        arguments.count = static_cast<uint8_t>(sizeof...(Args));
+        //--------------------------
+        return (detail::put_argument(arguments, args) && ...);
+        //--------------------------
+    } // end bool capture(CapturedArguments& arguments, const Args&... args)
+    //--------------------------------------------------------------
+    // **Produces the text the eager path would have produced**
+    //--------------------------------------------------------------
+    std::string render(std::string_view format, const CapturedArguments& arguments);
+    //--------------------------
+    void render_to(std::string& output, std::string_view format, const std::byte* data, const size_t& size);
+    //--------------------------------------------------------------
+} // end namespace Logger
+//--------------------------------------------------------------
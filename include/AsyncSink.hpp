@@ -0,0 +1,95 @@
+#pragma once
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+//--------------------------------------------------------------
+// Logger library
+//--------------------------------------------------------------
+#include "Sink.hpp"
+//--------------------------------------------------------------
+namespace Logger {
+    //--------------------------------------------------------------
+    struct AsyncSinkOptions {
+        size_t capacity                             = 4096UL;   // Records queued before the policy below applies
+        std::chrono::milliseconds poll_interval     = std::chrono::milliseconds(10);
+        bool block_when_full                        = true;     // false drops new records and counts them
+    }; // end struct AsyncSinkOptions
+    //--------------------------------------------------------------
+    // **Runs a sink on a thread of its own**
+    // Records with their formatted text, and trace events, are copied into a bounded ring and written, polled
+    // and flushed by the sink's thread, so a slow disk or network sink does not hold up the
+    // logger's writer or the other sinks. flush() waits until everything queued before the
+    // call has reached the wrapped sink and that sink has flushed.
+    //--------------------------------------------------------------
+    class AsyncSink : public Sink {
+        //--------------------------------------------------------------
+        public:
+            //--------------------------------------------------------------
+            explicit AsyncSink(std::shared_ptr<Sink> sink, const AsyncSinkOptions& options = AsyncSinkOptions());
+            ~AsyncSink(void) override;
+            //--------------------------
+            AsyncSink(void)                         = delete;
+            AsyncSink(const AsyncSink&)             = delete;
+            AsyncSink& operator=(const AsyncSink&)  = delete;
+            AsyncSink(AsyncSink&&)                  = delete;
+            AsyncSink& operator=(AsyncSink&&)       = delete;
+            //--------------------------
+            void write(const LogRecord& record, std::string_view formatted) override;
+            //--------------------------
+            // **Queued with the records, the wrapped sink sees both in the order they arrived**
+            void write_trace(const TraceEvent& event) override;
+            //--------------------------
+            void flush(void) override;
+            //--------------------------
+            // **Forwards to the wrapped sink; records still queued are lost**
+            void write_pending(void) noexcept override;
+            //--------------------------
+            // **Records and trace events dropped because the ring was full**
+            uint64_t dropped(void) const;
+            //--------------------------------------------------------------
+        private:
+            //--------------------------------------------------------------
+            struct Entry {
+                LogRecord record;
+                std::string formatted;
+                TraceEvent event;
+                bool is_trace = false;
+            }; // end struct Entry
+            //--------------------------
+            // **The next free slot, waiting for room or null when the record is dropped; m_mutex held**
+            Entry* claim(std::unique_lock<std::mutex>& lock);
+            //--------------------------
+            void worker_loop(void);
+            //--------------------------------------------------------------
+            std::shared_ptr<Sink> m_sink;
+            AsyncSinkOptions m_options;
+            //--------------------------
+            // [m_head, m_tail) is owned by the worker, the rest by write(); both guarded by m_mutex
+            std::vector<Entry> m_entries;
+            uint64_t m_head;
+            uint64_t m_tail;
+            //--------------------------
+            uint64_t m_flush_requested;
+            uint64_t m_flush_completed;
+            bool m_running;
+            std::atomic<uint64_t> m_dropped;
+            //--------------------------
+            std::mutex m_mutex;
+            std::condition_variable m_work_cv;  // Records queued, flush requested or stopping
+            std::condition_variable m_done_cv;  // Room in the ring or a flush completed
+            std::thread m_worker;
+        //--------------------------------------------------------------
+    }; // end class AsyncSink
+    //--------------------------------------------------------------
+} // end namespace Logger
+//--------------------------------------------------------------
@@ -0,0 +1,52 @@
+#pragma once
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <cstdint>
+#include <string>
+#include <string_view>
+//--------------------------------------------------------------
+// **Layout of the files written by BinarySink**
+//
+//  file    := session*
+//  session := MAGIC precision:u8 entry*
+//  entry   := SITE   id:varint level:u8 format:bytes file:bytes line:varint count:varint type:u8*
+//           | RECORD id:varint delta_ns:zigzag-varint argument*
+//  bytes   := length:varint u8*
+//
+// Arguments use the types of their site: integers as (zigzag) varints,
+// FLOAT/DOUBLE as raw little-endian bytes, BOOL/CHAR as one byte, STRING as bytes.
+// Every session restarts site ids and the timestamp base.
+//--------------------------------------------------------------
+namespace Logger::BinaryFormat {
+    //--------------------------------------------------------------
+    inline constexpr std::string_view MAGIC = "LOGBIN1\n";
+    //--------------------------------------------------------------
+    enum class Entry : uint8_t {
+        SITE    = 0x01,
+        RECORD  = 0x02
+    }; // end enum class Entry : uint8_t
+    //--------------------------------------------------------------
+    inline void put_varint(std::string& output, uint64_t value) {
+        while (value >= 0x80UL) {
+            output.push_back(static_cast<char>((value & 0x7FUL) | 0x80UL));
+            value >>= 7U;
+        } // end while (value >= 0x80UL)
+        output.push_back(static_cast<char>(value));
+    } // end inline void put_varint(std::string& output, uint64_t value)
+    //--------------------------------------------------------------
+    inline void put_bytes(std::string& output, std::string_view bytes) {
+        put_varint(output, bytes.size());
+        output.append(bytes);
+    } // end inline void put_bytes(std::string& output, std::string_view bytes)
+    //--------------------------------------------------------------
+    constexpr uint64_t zigzag(const int64_t& value) {
+        return (static_cast<uint64_t>(value) << 1U) ^ static_cast<uint64_t>(value >> 63U);
+    } // end constexpr uint64_t zigzag(const int64_t& value)
+    //--------------------------------------------------------------
+    constexpr int64_t unzigzag(const uint64_t& value) {
+        return static_cast<int64_t>(value >> 1U) ^ -static_cast<int64_t>(value & 1U);
+    } // end constexpr int64_t unzigzag(const uint64_t& value)
+    //--------------------------------------------------------------
+} // end namespace Logger::BinaryFormat
+//--------------------------------------------------------------
@@ -0,0 +1,125 @@
+#pragma once
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+//--------------------------------------------------------------
+// Logger library
+//--------------------------------------------------------------
+#include "Sink.hpp"
+#include "FileSink.hpp"
+#include "Timestamp.hpp"
+//--------------------------------------------------------------
+namespace Logger {
+    //--------------------------------------------------------------
+    // **Compact binary log: each call site's format string is written once,
+    // records carry only the site id, a timestamp delta and the arguments**
+    //--------------------------------------------------------------
+    class BinarySink : public Sink {
+        //--------------------------------------------------------------
+        public:
+            //--------------------------------------------------------------
+            explicit BinarySink(std::string filename, const FileSinkOptions& options = FileSinkOptions());
+            ~BinarySink(void) override;
+            //--------------------------
+            BinarySink(void)                            = delete;
+            BinarySink(const BinarySink&)               = delete;
+            BinarySink& operator=(const BinarySink&)    = delete;
+            BinarySink(BinarySink&&)                    = delete;
+            BinarySink& operator=(BinarySink&&)         = delete;
+            //--------------------------
+            void write(const LogRecord& record, std::string_view formatted) override;
+            //--------------------------
+            void flush(void) override;
+            //--------------------------
+            void poll(const std::chrono::steady_clock::time_point& now) override;
+            //--------------------------
+            void set_batching(const bool& enabled) override;
+            //--------------------------
+            void write_pending(void) noexcept override;
+            //--------------------------------------------------------------
+        private:
+            //--------------------------------------------------------------
+            // **Call site: the format pointer of a literal, null for eager and structured records**
+            struct SiteKey {
+                const char* format;
+                const char* file;
+                uint32_t line;
+                LogLevel level;
+                //--------------------------
+                bool operator==(const SiteKey& other) const = default;
+            }; // end struct SiteKey
+            //--------------------------
+            struct SiteKeyHash {
+                size_t operator()(const SiteKey& key) const;
+            }; // end struct SiteKeyHash
+            //--------------------------
+            // **One per argument signature seen at a site; more than one only for templated callers**
+            struct Signature {
+                std::string types;
+                uint32_t id;
+            }; // end struct Signature
+            //--------------------------
+            // **Id of the site with m_types as its signature, written to m_entry when new**
+            uint32_t site(const SiteKey& key, std::string_view format);
+            //--------------------------------------------------------------
+            FileSink m_file;
+            std::unordered_map<SiteKey, std::vector<Signature>, SiteKeyHash> m_sites;
+            uint32_t m_site_count;
+            //--------------------------
+            // Reused from record to record
+            std::string m_types;
+            std::string m_arguments;
+            std::string m_message;
+            std::string m_entry;
+            int64_t m_last_time;
+            bool m_started;
+        //--------------------------------------------------------------
+    }; // end class BinarySink
+    //--------------------------------------------------------------
+    // **Turns a BinarySink file back into the lines the console showed**
+    //--------------------------------------------------------------
+    class BinaryDecoder {
+        //--------------------------------------------------------------
+        public:
+            //--------------------------------------------------------------
+            explicit BinaryDecoder(std::istream& input);
+            //--------------------------
+            BinaryDecoder(void)                             = delete;
+            BinaryDecoder(const BinaryDecoder&)             = delete;
+            BinaryDecoder& operator=(const BinaryDecoder&)  = delete;
+            BinaryDecoder(BinaryDecoder&&)                  = delete;
+            BinaryDecoder& operator=(BinaryDecoder&&)       = delete;
+            //--------------------------
+            // **Decodes the next record, false at the end of the input; throws std::runtime_error on corrupt data**
+            bool next(std::string& line);
+            //--------------------------------------------------------------
+        private:
+            //--------------------------------------------------------------
+            struct Site {
+                LogLevel level;
+                std::string format;
+                std::vector<ArgumentType> types;
+            }; // end struct Site
+            //--------------------------
+            uint8_t read_byte(void);
+            uint64_t read_varint(void);
+            std::string read_bytes(void);
+            void read_raw(void* destination, const size_t& size);
+            void read_session(void);
+            //--------------------------------------------------------------
+            std::istream& m_input;
+            std::vector<Site> m_sites;
+            std::string m_arguments;
+            int64_t m_last_time;
+            TimestampPrecision m_precision;
+        //--------------------------------------------------------------
+    }; // end class BinaryDecoder
+    //--------------------------------------------------------------
+} // end namespace Logger
+//--------------------------------------------------------------
@@ -0,0 +1,74 @@
+#pragma once
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+//--------------------------------------------------------------
+// Logger library
+//--------------------------------------------------------------
+#include "Sink.hpp"
+#include "FileSink.hpp"
+#include "Trace.hpp"
+//--------------------------------------------------------------
+namespace Logger {
+    //--------------------------------------------------------------
+    // **Chrome trace-event JSON, opened by chrome://tracing and ui.perfetto.dev**
+    //
+    //  [{"name":"db.query","cat":"scope","ph":"X","ts":1520.125,"dur":87.500,"pid":4242,"tid":4243}
+    //  ,{"name":"cache miss","cat":"log","ph":"i","s":"t","ts":1600.000,"pid":4242,"tid":4243,"args":{"level":"DEBUG"}}
+    //  ]
+    //
+    // Scopes and marks become duration events, records of the sink's levels become instant events.
+    // Times are microseconds since the sink was created. One event per line; the closing bracket is
+    // written on destruction, and the viewers load a file without it. Rotation is turned off so a
+    // trace is never split.
+    //--------------------------------------------------------------
+    class ChromeTraceSink : public Sink {
+        //--------------------------------------------------------------
+        public:
+            //--------------------------------------------------------------
+            explicit ChromeTraceSink(std::string filename, const FileSinkOptions& options = FileSinkOptions());
+            ~ChromeTraceSink(void) override;
+            //--------------------------
+            ChromeTraceSink(void)                               = delete;
+            ChromeTraceSink(const ChromeTraceSink&)             = delete;
+            ChromeTraceSink& operator=(const ChromeTraceSink&)  = delete;
+            ChromeTraceSink(ChromeTraceSink&&)                  = delete;
+            ChromeTraceSink& operator=(ChromeTraceSink&&)       = delete;
+            //--------------------------
+            void write(const LogRecord& record, std::string_view formatted) override;
+            //--------------------------
+            void write_trace(const TraceEvent& event) override;
+            //--------------------------
+            void flush(void) override;
+            //--------------------------
+            void poll(const std::chrono::steady_clock::time_point& now) override;
+            //--------------------------
+            void set_batching(const bool& enabled) override;
+            //--------------------------
+            void write_pending(void) noexcept override;
+            //--------------------------------------------------------------
+        private:
+            //--------------------------------------------------------------
+            // **Separator, name, category, phase and timestamp of one event**
+            void open_event(std::string_view name, std::string_view category, const char& phase,
+                            const std::chrono::system_clock::time_point& time);
+            //--------------------------
+            // **",\"pid\":P,\"tid\":T" closing the common members**
+            void append_ids(const uint64_t& thread);
+            //--------------------------
+            void append_microseconds(const int64_t& nanoseconds);
+            //--------------------------------------------------------------
+            FileSink m_file;
+            std::string m_line;
+            bool m_first;
+            const std::chrono::system_clock::time_point m_epoch;
+            const uint64_t m_pid;
+        //--------------------------------------------------------------
+    }; // end class ChromeTraceSink
+    //--------------------------------------------------------------
+} // end namespace Logger
+//--------------------------------------------------------------
@@ -0,0 +1,79 @@
+#pragma once
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+//--------------------------------------------------------------
+namespace Logger {
+    //--------------------------------------------------------------
+    enum class Compression : uint8_t {
+        NONE    = 0,
+        AUTO    = 1, // Best codec compiled in: zstd, then gzip, else none
+        GZIP    = 2, // Needs zlib (LOGGER_HAS_ZLIB)
+        ZSTD    = 3  // Needs libzstd (LOGGER_HAS_ZSTD)
+    }; // end enum class Compression : uint8_t
+    //--------------------------------------------------------------
+    // **Low-priority background thread that compresses rotated log files and prunes old generations**
+    // Generations are named <filename>.1, <filename>.2, ... with the highest number being the newest.
+    //--------------------------------------------------------------
+    class Compressor {
+        //--------------------------------------------------------------
+        public:
+            //--------------------------------------------------------------
+            // **Shared by every rotating FileSink, the thread exits with the last of them**
+            static std::shared_ptr<Compressor> shared(void);
+            //--------------------------
+            Compressor(void);
+            ~Compressor(void);
+            //--------------------------
+            Compressor(const Compressor&)               = delete;
+            Compressor& operator=(const Compressor&)    = delete;
+            Compressor(Compressor&&)                    = delete;
+            Compressor& operator=(Compressor&&)         = delete;
+            //--------------------------
+            // **Compresses generation of filename, then deletes generations older than the newest max_files**
+            void submit(const std::string& filename, const uint32_t& generation, const size_t& max_files, const Compression& compression);
+            //--------------------------
+            // **Blocks until every submitted job is done**
+            void wait(void);
+            //--------------------------
+            // **Codec Compression::AUTO and unavailable codecs resolve to**
+            static Compression resolve(const Compression& compression);
+            //--------------------------
+            static std::string generation_path(const std::string& filename, const uint32_t& generation);
+            //--------------------------
+            // **Highest generation number present on disk, compressed or not, 0 when there is none**
+            static uint32_t last_generation(const std::string& filename);
+            //--------------------------------------------------------------
+        private:
+            //--------------------------------------------------------------
+            struct Job {
+                std::string filename;
+                uint32_t generation;
+                size_t max_files;
+                Compression compression;
+            }; // end struct Job
+            //--------------------------
+            void run(void);
+            //--------------------------
+            static void compress(const std::string& path, const Compression& compression);
+            static void prune(const std::string& filename, const uint32_t& newest, const size_t& max_files);
+            //--------------------------------------------------------------
+            std::mutex m_mutex;
+            std::condition_variable m_cv;
+            std::condition_variable m_idle_cv;
+            std::deque<Job> m_jobs;
+            bool m_busy;
+            bool m_stop;
+            std::thread m_thread;
+        //--------------------------------------------------------------
+    }; // end class Compressor
+    //--------------------------------------------------------------
+} // end namespace Logger
+//--------------------------------------------------------------
@@ -0,0 +1,88 @@
+#pragma once
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <cstdio>
+#include <cstdint>
+#include <chrono>
+#include <string>
+#include <string_view>
+//--------------------------------------------------------------
+// Logger library
+//--------------------------------------------------------------
+#include "Sink.hpp"
+//--------------------------------------------------------------
+namespace Logger {
+    //--------------------------------------------------------------
+    enum class ColorMode : uint8_t {
+        AUTO    = 0, // Colors only when the stream is a terminal
+        ALWAYS  = 1,
+        NEVER   = 2
+    }; // end enum class ColorMode : uint8_t
+    //--------------------------------------------------------------
+    struct ConsoleSinkOptions {
+        size_t buffer_size                          = 64UL * 1024UL;
+        std::chrono::milliseconds flush_interval    = std::chrono::milliseconds(100);
+        ColorMode color                             = ColorMode::AUTO;
+        bool errors_to_stderr                       = false;
+    }; // end struct ConsoleSinkOptions
+    //--------------------------------------------------------------
+    // **Collects console lines and hands them to stdout/stderr with one write per batch**
+    // In synchronous mode every line is written at once. With batching on (asynchronous mode)
+    // a terminal gets the lines after each writer pass; a file or pipe gets a write when the
+    // buffer fills, once the flush interval has passed, or on flush.
+    //--------------------------------------------------------------
+    class ConsoleSink : public Sink {
+        //--------------------------------------------------------------
+        public:
+            //--------------------------------------------------------------
+            explicit ConsoleSink(const ConsoleSinkOptions& options = ConsoleSinkOptions());
+            ~ConsoleSink(void) override;
+            //--------------------------
+            ConsoleSink(const ConsoleSink&)             = delete;
+            ConsoleSink& operator=(const ConsoleSink&)  = delete;
+            ConsoleSink(ConsoleSink&&)                  = delete;
+            ConsoleSink& operator=(ConsoleSink&&)       = delete;
+            //--------------------------
+            void write(const LogRecord& record, std::string_view formatted) override;
+            void write(const LogLevel& level, std::string_view formatted);
+            //--------------------------
+            void flush(void) override;
+            //--------------------------
+            void poll(const std::chrono::steady_clock::time_point& now) override;
+            //--------------------------
+            void write_pending(void) noexcept override;
+            //--------------------------
+            // **The stream a record of the level is written to**
+            int descriptor(const LogLevel& level) const;
+            //--------------------------
+            void set_options(const ConsoleSinkOptions& options);
+            //--------------------------
+            // **Holds output back until the next flush or poll**
+            void set_batching(const bool& enabled) override;
+            //--------------------------------------------------------------
+        private:
+            //--------------------------------------------------------------
+            struct Stream {
+                std::FILE* file;
+                int descriptor;
+                bool terminal;
+                bool color;
+                std::string buffer;
+            }; // end struct Stream
+            //--------------------------
+            void configure(Stream& stream);
+            void commit(Stream& stream);
+            //--------------------------
+            static bool write_all(const int& descriptor, std::string_view data) noexcept;
+            //--------------------------------------------------------------
+            ConsoleSinkOptions m_options;
+            Stream m_out;
+            Stream m_err;
+            std::chrono::steady_clock::time_point m_last_commit;
+            bool m_batching;
+        //--------------------------------------------------------------
+    }; // end class ConsoleSink
+    //--------------------------------------------------------------
+} // end namespace Logger
+//--------------------------------------------------------------
@@ -0,0 +1,36 @@
+#pragma once
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <string_view>
+//--------------------------------------------------------------
+namespace Logger {
+    //--------------------------------------------------------------
+    // **Opt-in rescue of buffered log output on fatal signals and std::terminate (POSIX)**
+    // On SIGSEGV, SIGABRT, SIGBUS, SIGFPE and SIGILL the handler writes the console and log file
+    // buffers and the records still queued in the per-thread rings with write(2) on descriptors
+    // opened by install(), appends a marker line naming the signal, restores the previous
+    // disposition and re-raises. Nothing is locked, so it is best effort: a record that was
+    // being written when the process crashed may come out incomplete.
+    //--------------------------------------------------------------
+    class CrashHandler {
+        //--------------------------------------------------------------
+        public:
+            //--------------------------------------------------------------
+            static void install(void);
+            static void uninstall(void);
+            //--------------------------
+            static bool is_installed(void);
+            //--------------------------------------------------------------
+        private:
+            //--------------------------------------------------------------
+            static void handle_signal(int signal);
+            static void handle_terminate(void);
+            //--------------------------
+            // **Async-signal-safe: everything the logger still holds, then "<time> [CRASH]: reason"**
+            static void write_pending(std::string_view reason) noexcept;
+        //--------------------------------------------------------------
+    }; // end class CrashHandler
+    //--------------------------------------------------------------
+} // end namespace Logger
+//--------------------------------------------------------------
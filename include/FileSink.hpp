@@ -0,0 +1,117 @@
+#pragma once
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <atomic>
+#include <cstdio>
+#include <cstdint>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+//--------------------------------------------------------------
+// Logger library
+//--------------------------------------------------------------
+#include "Compressor.hpp"
+#include "Sink.hpp"
+//--------------------------------------------------------------
+namespace Logger {
+    //--------------------------------------------------------------
+    enum class Durability : uint8_t {
+        NONE        = 0, // Commit only when the buffer fills or on an explicit flush
+        FLUSH       = 1, // Also commit on the flush interval
+        FDATASYNC   = 2  // Also fdatasync every commit
+    }; // end enum class Durability : uint8_t
+    //--------------------------------------------------------------
+    struct FileSinkOptions {
+        size_t buffer_size                          = 64UL * 1024UL;
+        std::chrono::milliseconds flush_interval    = std::chrono::milliseconds(1000);
+        Durability durability                       = Durability::FLUSH;
+        bool header                                 = true; // "Log file created at" line in new files
+        //--------------------------
+        // Rotation: the file is renamed to <filename>.<n> (n growing) once either limit is reached
+        size_t max_size                             = 0UL;  // Bytes, 0 disables size-based rotation
+        std::chrono::seconds rotation_interval      = std::chrono::seconds(0); // Aligned to the UTC epoch, 0 disables
+        size_t max_files                            = 5UL;  // Rotated generations kept, 0 keeps all
+        Compression compression                     = Compression::AUTO;
+    }; // end struct FileSinkOptions
+    //--------------------------------------------------------------
+    // **Keeps a log file open and group-commits buffered lines**
+    // Registered with Logger::add_sink it writes the formatted line of every record it receives.
+    // Lines are grouped only while batching (asynchronous mode); otherwise each one is committed
+    // as it arrives unless the durability is NONE.
+    //--------------------------------------------------------------
+    class FileSink : public Sink {
+        //--------------------------------------------------------------
+        public:
+            //--------------------------------------------------------------
+            explicit FileSink(std::string filename, const FileSinkOptions& options = FileSinkOptions());
+            ~FileSink(void) override;
+            //--------------------------
+            FileSink(void)                          = delete;
+            FileSink(const FileSink&)               = delete;
+            FileSink& operator=(const FileSink&)    = delete;
+            FileSink(FileSink&&)                    = delete;
+            FileSink& operator=(FileSink&&)         = delete;
+            //--------------------------
+            void write(const LogRecord& record, std::string_view formatted) override;
+            void write(std::string_view message);
+            //--------------------------
+            // **Appends bytes as they are, without a line terminator**
+            void write_raw(std::string_view data);
+            //--------------------------
+            void flush(void) override;
+            //--------------------------
+            void poll(const std::chrono::steady_clock::time_point& now) override;
+            //--------------------------
+            void set_batching(const bool& enabled) override;
+            //--------------------------
+            void set_options(const FileSinkOptions& options);
+            //--------------------------
+            const std::string& filename(void) const;
+            //--------------------------
+            // **Opens the file now instead of on the first commit, so the crash handler has a descriptor**
+            void preopen(void);
+            //--------------------------
+            // **Async-signal-safe: hands the buffered bytes to write(2) and appends line, without locking**
+            void write_pending(std::string_view line) noexcept;
+            void write_pending(void) noexcept override;
+            //--------------------------
+            int descriptor(void) const;
+            //--------------------------
+            // **Bytes of committed batches the OS refused, e.g. on a full disk**
+            uint64_t lost_bytes(void) const;
+            //--------------------------
+            // **The "Log file created at" line written at the top of a new file**
+            static std::string header(const std::chrono::system_clock::time_point& created);
+            //--------------------------------------------------------------
+        private:
+            //--------------------------------------------------------------
+            bool open(void);
+            //--------------------------
+            void commit(void);
+            //--------------------------
+            bool rotation_due(const std::chrono::system_clock::time_point& now) const;
+            void rotate(void);
+            void schedule_rotation(const std::chrono::system_clock::time_point& now);
+            //--------------------------------------------------------------
+            std::string m_filename;
+            FileSinkOptions m_options;
+            std::FILE* m_file;
+            int m_descriptor;
+            std::string m_buffer;
+            std::chrono::steady_clock::time_point m_last_commit;
+            std::chrono::system_clock::time_point m_created; // Sink construction, then each rotation
+            bool m_batching;
+            //--------------------------
+            uint64_t m_size;
+            std::atomic<uint64_t> m_lost_bytes;
+            bool m_write_failed;
+            uint32_t m_generation;
+            std::chrono::system_clock::time_point m_next_rotation;
+            std::shared_ptr<Compressor> m_compressor;
+        //--------------------------------------------------------------
+    }; // end class FileSink
+    //--------------------------------------------------------------
+} // end namespace Logger
+//--------------------------------------------------------------
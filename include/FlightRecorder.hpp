@@ -0,0 +1,103 @@
+#pragma once
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+//--------------------------------------------------------------
+// Logger library
+//--------------------------------------------------------------
+#include "LogLevel.hpp"
+#include "LogRecord.hpp"
+//--------------------------------------------------------------
+namespace Logger {
+    //--------------------------------------------------------------
+    // **Which recorders a dump writes**
+    //--------------------------------------------------------------
+    enum class FlightScope : uint8_t {
+        THREAD      = 0, // The calling thread's
+        ALL_THREADS = 1  // Every thread's, one thread after the other
+    }; // end enum class FlightScope : uint8_t
+    //--------------------------------------------------------------
+    struct FlightRecorderOptions {
+        uint8_t levels              = static_cast<uint8_t>(LogLevel::DEBUG) | static_cast<uint8_t>(LogLevel::INFO); // Kept in memory instead of written, 0 turns the recorder off
+        size_t capacity             = 256UL;                // Records per thread, rounded up to a power of two; applies to threads that record from now on
+        size_t dump_records         = 64UL;                 // Most records per thread a dump writes
+        bool dump_on_error          = true;                 // Every ERROR is preceded by a dump
+        FlightScope error_scope     = FlightScope::THREAD;  // What that dump covers
+    }; // end struct FlightRecorderOptions
+    //--------------------------------------------------------------
+    // **The last records of one thread, overwritten continuously and written only by a dump**
+    // Deferred-capable calls keep the format and the raw arguments, the text is produced by the dump.
+    // The owning thread and a dump both take mutex(), which the owner finds uncontended unless a dump is reading.
+    //--------------------------------------------------------------
+    class FlightRecorder {
+        //--------------------------------------------------------------
+        public:
+            //--------------------------------------------------------------
+            FlightRecorder(const size_t& capacity, const uint64_t& thread) : m_slots(std::bit_ceil(capacity ? capacity : 1UL)),
+                                                                             m_mask(m_slots.size() - 1UL),
+                                                                             m_thread(thread) {
+                //--------------------------
+            } // end FlightRecorder(const size_t& capacity, const uint64_t& thread)
+            //--------------------------
+            FlightRecorder(const FlightRecorder&)               = delete;
+            FlightRecorder& operator=(const FlightRecorder&)    = delete;
+            //--------------------------
+            // **Slot for the next record, the oldest one once the ring is full; mutex() held**
+            LogRecord& next(void) {
+                const uint64_t _sequence = m_written.load(std::memory_order_relaxed);
+                m_written.store(_sequence + 1UL, std::memory_order_release);
+                return m_slots[_sequence & m_mask];
+            } // end LogRecord& next(void)
+            //--------------------------
+            // **Sequence of the oldest of the last count records before last not dumped yet; end() is one past the newest**
+            uint64_t begin(const size_t& count, const uint64_t& last) const {
+                const uint64_t _end     = end();
+                const uint64_t _oldest  = std::max<uint64_t>(m_dumped, _end - std::min<uint64_t>(_end, m_slots.size()));
+                if (last <= _oldest) {
+                    return last;
+                } // end if (last <= _oldest)
+                return last - std::min<uint64_t>(last - _oldest, count);
+            } // end uint64_t begin(const size_t& count, const uint64_t& last) const
+            //--------------------------
+            uint64_t end(void) const {
+                return m_written.load(std::memory_order_acquire);
+            } // end uint64_t end(void) const
+            //--------------------------
+            LogRecord& at(const uint64_t& sequence) {
+                return m_slots[sequence & m_mask];
+            } // end LogRecord& at(const uint64_t& sequence)
+            //--------------------------
+            // **The next dump starts after last; mutex() held**
+            void mark_dumped(const uint64_t& last) {
+                m_dumped = std::max(m_dumped, last);
+            } // end void mark_dumped(const uint64_t& last)
+            //--------------------------
+            uint64_t thread(void) const {
+                return m_thread;
+            } // end uint64_t thread(void) const
+            //--------------------------
+            std::mutex& mutex(void) {
+                return m_mutex;
+            } // end std::mutex& mutex(void)
+            //--------------------------
+            std::atomic<bool> closed{false}; // Set when the owning thread exits
+            //--------------------------------------------------------------
+        private:
+            //--------------------------------------------------------------
+            std::mutex m_mutex;
+            std::vector<LogRecord> m_slots;
+            const uint64_t m_mask;
+            const uint64_t m_thread;
+            std::atomic<uint64_t> m_written{0UL};   // Atomic for the crash handler, which reads without the mutex
+            uint64_t m_dumped{0UL};
+        //--------------------------------------------------------------
+    }; // end class FlightRecorder
+    //--------------------------------------------------------------
+} // end namespace Logger
+//--------------------------------------------------------------
@@ -0,0 +1,39 @@
+#pragma once
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <string>
+//--------------------------------------------------------------
+// Logger library
+//--------------------------------------------------------------
+#include "LogRecord.hpp"
+//--------------------------------------------------------------
+namespace Logger {
+    //--------------------------------------------------------------
+    // **Renders a record into the text handed to sinks**
+    // Each formatter runs at most once per record, sinks sharing it share the output.
+    // Called with the logger's write lock held, never concurrently.
+    //--------------------------------------------------------------
+    class Formatter {
+        //--------------------------------------------------------------
+        public:
+            //--------------------------------------------------------------
+            virtual ~Formatter(void) = default;
+            //--------------------------
+            // **output is cleared by the formatter; its capacity is kept between records**
+            virtual void format(const LogRecord& record, std::string& output) = 0;
+        //--------------------------------------------------------------
+    }; // end class Formatter
+    //--------------------------------------------------------------
+    // **"2024-05-01 12:00:00 [INFO]: message key=value", the console and log file line**
+    //--------------------------------------------------------------
+    class TextFormatter : public Formatter {
+        //--------------------------------------------------------------
+        public:
+            //--------------------------------------------------------------
+            void format(const LogRecord& record, std::string& output) override;
+        //--------------------------------------------------------------
+    }; // end class TextFormatter
+    //--------------------------------------------------------------
+} // end namespace Logger
+//--------------------------------------------------------------
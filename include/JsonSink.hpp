@@ -0,0 +1,79 @@
+#pragma once
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+//--------------------------------------------------------------
+// Logger library
+//--------------------------------------------------------------
+#include "Sink.hpp"
+#include "FileSink.hpp"
+#include "Timestamp.hpp"
+//--------------------------------------------------------------
+namespace Logger {
+    //--------------------------------------------------------------
+    // **One JSON object per line for log ingestion**
+    //
+    //  {"time":"2024-05-01T12:00:00.123Z","level":"INFO","file":"main.cpp","line":42,"thread":1234,
+    //   "message":"request done","latency_us":250,"status":"ok"}
+    //
+    // Times are UTC. The level and call-site members are encoded once per call site;
+    // LOG_*_KV fields follow the message, plain LOG_* and *_STREAM records carry the message only.
+    //--------------------------------------------------------------
+    class JsonSink : public Sink {
+        //--------------------------------------------------------------
+        public:
+            //--------------------------------------------------------------
+            explicit JsonSink(std::string filename, const FileSinkOptions& options = FileSinkOptions());
+            ~JsonSink(void) override;
+            //--------------------------
+            JsonSink(void)                          = delete;
+            JsonSink(const JsonSink&)               = delete;
+            JsonSink& operator=(const JsonSink&)    = delete;
+            JsonSink(JsonSink&&)                    = delete;
+            JsonSink& operator=(JsonSink&&)         = delete;
+            //--------------------------
+            void write(const LogRecord& record, std::string_view formatted) override;
+            //--------------------------
+            void flush(void) override;
+            //--------------------------
+            void poll(const std::chrono::steady_clock::time_point& now) override;
+            //--------------------------
+            void set_batching(const bool& enabled) override;
+            //--------------------------
+            void write_pending(void) noexcept override;
+            //--------------------------------------------------------------
+        private:
+            //--------------------------------------------------------------
+            struct SiteKey {
+                const char* file;
+                uint32_t line;
+                LogLevel level;
+                //--------------------------
+                bool operator==(const SiteKey& other) const = default;
+            }; // end struct SiteKey
+            //--------------------------
+            struct SiteKeyHash {
+                size_t operator()(const SiteKey& key) const;
+            }; // end struct SiteKeyHash
+            //--------------------------
+            // **","level":"INFO","file":"main.cpp","line":42,"thread": for the record's call site**
+            const std::string& site(const LogRecord& record);
+            //--------------------------
+            void append_time(const std::chrono::system_clock::time_point& time);
+            //--------------------------------------------------------------
+            FileSink m_file;
+            std::unordered_map<SiteKey, std::string, SiteKeyHash> m_sites;
+            std::string m_line;
+            //--------------------------
+            // Calendar part of the last second written
+            int64_t m_second;
+            char m_date[Timestamp::SECONDS_LENGTH];
+        //--------------------------------------------------------------
+    }; // end class JsonSink
+    //--------------------------------------------------------------
+} // end namespace Logger
+//--------------------------------------------------------------
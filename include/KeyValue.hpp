@@ -0,0 +1,149 @@
+#pragma once
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+//--------------------------------------------------------------
+// Logger library
+//--------------------------------------------------------------
+#include "LogLevel.hpp"
+//--------------------------------------------------------------
+#if __cpp_lib_format
+    #include <format>
+#else
+    #include <fmt/core.h>
+#endif
+//--------------------------------------------------------------
+namespace Logger::Json {
+    //--------------------------------------------------------------
+    // **Appends text with quotes, backslashes and control characters escaped; other bytes are copied in runs**
+    //--------------------------------------------------------------
+    void escape(std::string& output, std::string_view text);
+    //--------------------------------------------------------------
+    // **Appends value as a JSON value: numbers and booleans bare, everything else as a string**
+    //--------------------------------------------------------------
+    template<typename T>
+    void encode(std::string& output, const T& value) {
+        //--------------------------
+        using Type = std::decay_t<T>;
+        //--------------------------
+        if constexpr (std::is_same_v<Type, bool>) {
+            output.append(value ? "true" : "false");
+        } else if constexpr (std::is_same_v<Type, std::nullptr_t>) {
+            output.append("null");
+        } else if constexpr (std::is_same_v<Type, char>) {
+            output.push_back('"');
+            escape(output, std::string_view(&value, 1UL));
+            output.push_back('"');
+        } else if constexpr (std::is_enum_v<Type>) {
+            encode(output, static_cast<std::underlying_type_t<Type>>(value));
+        } else if constexpr (std::is_arithmetic_v<Type>) {
+            //--------------------------
+            if constexpr (std::is_floating_point_v<Type>) {
+                if (!std::isfinite(value)) {
+                    output.append("null"); // JSON has no NaN or infinity
+                    return;
+                } // end if (!std::isfinite(value))
+            } // end if constexpr (std::is_floating_point_v<Type>)
+            //--------------------------
+            char _buffer[32];
+            const auto _result = std::to_chars(_buffer, _buffer + sizeof(_buffer), value);
+            output.append(_buffer, _result.ptr);
+            //--------------------------
+        } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            output.push_back('"');
+            escape(output, std::string_view(value));
+            output.push_back('"');
+        } else {
+            //--------------------------
+            // Anything with a formatter ends up as its text
+#if __cpp_lib_format
+            const std::string _text = std::format("{}", value);
+#else
+            const std::string _text = fmt::format("{}", value);
+#endif
+            output.push_back('"');
+            escape(output, _text);
+            output.push_back('"');
+            //--------------------------
+        } // end if constexpr (std::is_same_v<Type, bool>)
+        //--------------------------
+    } // end void encode(std::string& output, const T& value)
+    //--------------------------------------------------------------
+} // end namespace Logger::Json
+//--------------------------------------------------------------
+namespace Logger {
+    //--------------------------------------------------------------
+    // **Keys of one LOG_*_KV call site, encoded once for the text and the JSON output**
+    // Records carry only the encoded values, each followed by a '\0' (escaping keeps
+    // it out of the values), and point back to their site for the keys.
+    //--------------------------------------------------------------
+    class KeyValueSite {
+        //--------------------------------------------------------------
+        public:
+            //--------------------------------------------------------------
+            KeyValueSite(void) = default;
+            //--------------------------
+            KeyValueSite(const KeyValueSite&)               = delete;
+            KeyValueSite& operator=(const KeyValueSite&)    = delete;
+            KeyValueSite(KeyValueSite&&)                    = delete;
+            KeyValueSite& operator=(KeyValueSite&&)         = delete;
+            //--------------------------
+            // **Takes the keys of the first call, later calls only check a flag**
+            template<typename... Pairs>
+            void prepare(const Pairs&... pairs) {
+                if (LOGGER_LIKELY(m_ready.load(std::memory_order_acquire))) {
+                    return;
+                } // end if (LOGGER_LIKELY(m_ready.load(std::memory_order_acquire)))
+                std::call_once(m_once, [&] {
+                    for_each_pair(std::forward_as_tuple(pairs...), [this](const auto& key, const auto&) {
+                        static_assert(std::is_convertible_v<decltype(key), std::string_view>, "LOG_*_KV keys must be strings");
+                        add_key(key);
+                    }, std::make_index_sequence<sizeof...(Pairs) / 2UL>());
+                    m_ready.store(true, std::memory_order_release);
+                });
+            } // end void prepare(const Pairs&... pairs)
+            //--------------------------
+            template<typename... Pairs>
+            static void encode_values(std::string& output, const Pairs&... pairs) {
+                for_each_pair(std::forward_as_tuple(pairs...), [&output](const auto&, const auto& value) {
+                    Json::encode(output, value);
+                    output.push_back('\0');
+                }, std::make_index_sequence<sizeof...(Pairs) / 2UL>());
+            } // end static void encode_values(std::string& output, const Pairs&... pairs)
+            //--------------------------
+            // **" key=value" for every field**
+            void append_text(std::string& output, std::string_view fields) const;
+            //--------------------------
+            // **,"key":value for every field**
+            void append_json(std::string& output, std::string_view fields) const;
+            //--------------------------------------------------------------
+        private:
+            //--------------------------------------------------------------
+            template<typename Tuple, typename Visitor, size_t... I>
+            static void for_each_pair(const Tuple& pairs, Visitor&& visitor, std::index_sequence<I...>) {
+                (visitor(std::get<2UL * I>(pairs), std::get<2UL * I + 1UL>(pairs)), ...);
+            } // end static void for_each_pair(const Tuple& pairs, Visitor&& visitor, std::index_sequence<I...>)
+            //--------------------------
+            void add_key(std::string_view key);
+            //--------------------------------------------------------------
+            std::once_flag m_once;
+            std::atomic<bool> m_ready{false};
+            std::vector<std::string> m_text_keys;
+            std::vector<std::string> m_json_keys;
+        //--------------------------------------------------------------
+    }; // end class KeyValueSite
+    //--------------------------------------------------------------
+} // end namespace Logger
+//--------------------------------------------------------------
@@ -0,0 +1,136 @@
+#pragma once
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+//--------------------------------------------------------------
+// **Compile-time minimum level, call sites below it are removed entirely**
+//--------------------------------------------------------------
+#define LOGGER_LEVEL_DEBUG      0
+#define LOGGER_LEVEL_INFO       1
+#define LOGGER_LEVEL_WARNING    2
+#define LOGGER_LEVEL_ERROR      3
+#define LOGGER_LEVEL_OFF        4
+//--------------------------------------------------------------
+#ifndef LOGGER_MIN_LEVEL
+    #define LOGGER_MIN_LEVEL LOGGER_LEVEL_DEBUG
+#endif
+//--------------------------------------------------------------
+#if defined(__GNUC__) || defined(__clang__)
+    #define LOGGER_LIKELY(x)    __builtin_expect(!!(x), 1)
+    #define LOGGER_UNLIKELY(x)  __builtin_expect(!!(x), 0)
+#else
+    #define LOGGER_LIKELY(x)    (x)
+    #define LOGGER_UNLIKELY(x)  (x)
+#endif
+//--------------------------------------------------------------
+namespace Logger {
+    //--------------------------------------------------------------
+    enum class LogLevel : uint8_t {
+        DEBUG   = 1 << 0,
+        ERROR   = 1 << 1,
+        WARNING = 1 << 2,
+        INFO    = 1 << 3
+    }; // end enum class LogLevel : uint8_t
+    //--------------------------------------------------------------
+    constexpr size_t LEVEL_COUNT = 4UL;
+    //--------------------------------------------------------------
+    // **Position of the level in per-level tables: DEBUG 0, ERROR 1, WARNING 2, INFO 3**
+    //--------------------------------------------------------------
+    constexpr size_t level_index(const LogLevel& level) {
+        return static_cast<size_t>(std::countr_zero(static_cast<uint8_t>(level)));
+    } // end constexpr size_t level_index(const LogLevel& level)
+    //--------------------------------------------------------------
+    // **Mask of every level at or above the given severity**
+    //--------------------------------------------------------------
+    constexpr uint8_t level_mask(const LogLevel& minimum) {
+        switch (minimum) {
+            case LogLevel::DEBUG:
+                return static_cast<uint8_t>(LogLevel::DEBUG) | static_cast<uint8_t>(LogLevel::INFO) |
+                       static_cast<uint8_t>(LogLevel::WARNING) | static_cast<uint8_t>(LogLevel::ERROR);
+            case LogLevel::INFO:
+                return static_cast<uint8_t>(LogLevel::INFO) | static_cast<uint8_t>(LogLevel::WARNING) |
+                       static_cast<uint8_t>(LogLevel::ERROR);
+            case LogLevel::WARNING:
+                return static_cast<uint8_t>(LogLevel::WARNING) | static_cast<uint8_t>(LogLevel::ERROR);
+            case LogLevel::ERROR:
+                return static_cast<uint8_t>(LogLevel::ERROR);
+            default:
+                return 0U;
+        } // end switch (minimum)
+    } // end constexpr uint8_t level_mask(const LogLevel& minimum)
+    //--------------------------------------------------------------
+    constexpr std::string_view level_tag(const LogLevel& level) {
+        switch (level) {
+            case LogLevel::DEBUG:
+                return " [DEBUG]: ";
+            case LogLevel::ERROR:
+                return " [ERROR]: ";
+            case LogLevel::WARNING:
+                return " [WARNING]: ";
+            case LogLevel::INFO:
+                return " [INFO]: ";
+            default:
+                return " [UNKNOWN]: ";
+        } // end switch (level)
+    } // end constexpr std::string_view level_tag(const LogLevel& level)
+    //--------------------------------------------------------------
+    constexpr std::string_view level_name(const LogLevel& level) {
+        return level_tag(level).substr(2UL, level_tag(level).size() - 5UL);
+    } // end constexpr std::string_view level_name(const LogLevel& level)
+    //--------------------------------------------------------------
+    // **Every level, most severe first**
+    //--------------------------------------------------------------
+    constexpr std::array<LogLevel, LEVEL_COUNT> LEVELS{LogLevel::ERROR, LogLevel::WARNING, LogLevel::INFO, LogLevel::DEBUG};
+    //--------------------------------------------------------------
+    // **Runtime threshold for one subsystem, falls back to the global one until set**
+    //--------------------------------------------------------------
+    class Category {
+        //--------------------------------------------------------------
+        public:
+            //--------------------------------------------------------------
+            static constexpr uint8_t INHERIT = 1U << 7U;
+            //--------------------------
+            explicit Category(std::string name) : m_name(std::move(name)), m_mask(INHERIT) {
+                //--------------------------
+            } // end explicit Category(std::string name)
+            //--------------------------
+            Category(void)                          = delete;
+            Category(const Category&)               = delete;
+            Category& operator=(const Category&)    = delete;
+            Category(Category&&)                    = delete;
+            Category& operator=(Category&&)         = delete;
+            //--------------------------
+            bool is_enabled(const LogLevel& level, const uint8_t& global_mask) const {
+                const uint8_t _mask = m_mask.load(std::memory_order_relaxed);
+                return ((_mask & INHERIT) ? global_mask : _mask) & static_cast<uint8_t>(level);
+            } // end bool is_enabled(const LogLevel& level, const uint8_t& global_mask) const
+            //--------------------------
+            void set_level(const LogLevel& minimum) {
+                m_mask.store(level_mask(minimum), std::memory_order_relaxed);
+            } // end void set_level(const LogLevel& minimum)
+            //--------------------------
+            void reset(void) {
+                m_mask.store(INHERIT, std::memory_order_relaxed);
+            } // end void reset(void)
+            //--------------------------
+            const std::string& name(void) const {
+                return m_name;
+            } // end const std::string& name(void) const
+            //--------------------------------------------------------------
+        private:
+            //--------------------------------------------------------------
+            const std::string m_name;
+            std::atomic<uint8_t> m_mask;
+        //--------------------------------------------------------------
+    }; // end class Category
+    //--------------------------------------------------------------
+} // end namespace Logger
+//--------------------------------------------------------------
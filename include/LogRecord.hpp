@@ -0,0 +1,47 @@
+#pragma once
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+//--------------------------------------------------------------
+// Logger library
+//--------------------------------------------------------------
+#include "LogLevel.hpp"
+#include "ArgumentCapture.hpp"
+//--------------------------------------------------------------
+namespace Logger {
+    //--------------------------------------------------------------
+    class KeyValueSite;
+    class FlightRecorder;
+    //--------------------------------------------------------------
+    struct LogRecord {
+        LogLevel level;
+        std::chrono::system_clock::time_point time;
+        std::string message;
+        //--------------------------
+        // Set when the arguments were captured raw and the text is produced by the writer
+        std::string_view format;
+        CapturedArguments arguments;
+        //--------------------------
+        // Set by LOG_*_KV: the site holds the keys, fields the encoded values
+        const KeyValueSite* site = nullptr;
+        std::string fields;
+        //--------------------------
+        // Call site
+        const char* file    = nullptr;
+        uint32_t line       = 0U;
+        uint64_t thread     = 0UL; // OS thread id where available
+        //--------------------------
+        // Set on a queued ERROR whose flight dump the writer emits right before it: the producer's
+        // recorder, if any, and one past its newest record at the time of the call
+        bool flight_dump    = false;
+        uint64_t flight_end = 0UL;
+        std::shared_ptr<FlightRecorder> flight;
+    }; // end struct LogRecord
+    //--------------------------------------------------------------
+} // end namespace Logger
+//--------------------------------------------------------------
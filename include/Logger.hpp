@@ -7,7 +7,36 @@
 #include <chrono>
 #include <functional>
 #include <type_traits>
-#include <mutex>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <string>
+#include <condition_variable>
+#include <source_location>
+#include <vector>
+#include <utility>
+#include <tuple>
+#include <iterator>
+#include <string_view>
+#include <array>
+//--------------------------------------------------------------
+// Logger library
+//--------------------------------------------------------------
+#include "LogLevel.hpp"
+#include "SPSCQueue.hpp"
+#include "FileSink.hpp"
+#include "ConsoleSink.hpp"
+#include "ArgumentCapture.hpp"
+#include "LogRecord.hpp"
+#include "Sink.hpp"
+#include "Formatter.hpp"
+#include "Timestamp.hpp"
+#include "RateLimit.hpp"
+#include "ScratchBuffer.hpp"
+#include "KeyValue.hpp"
+#include "Metrics.hpp"
+#include "FlightRecorder.hpp"
+#include "Trace.hpp"
 //--------------------------------------------------------------
 #if __cpp_lib_format
     #include <format>
@@ -18,6 +47,53 @@
 #endif
 //--------------------------------------------------------------
 namespace Logger {
+    //--------------------------------------------------------------
+    // **Staging ring of one producer thread, drained by the writer thread**
+    //--------------------------------------------------------------
+    struct ThreadQueue {
+        explicit ThreadQueue(const size_t& capacity) : queue(capacity) {}
+        //--------------------------
+        SPSCQueue<LogRecord> queue;
+        std::atomic<bool> closed{false};    // Set when the owning thread exits
+        std::atomic<bool> producing{false}; // Set by the owning thread around an enqueue, awaited by stop_async()
+        size_t drained{0UL};                // Owned by the drainer: records taken in the current pass
+    }; // end struct ThreadQueue
+    //--------------------------------------------------------------
+    // **Trace events of one thread, handed to the trace sinks under the write lock**
+    //--------------------------------------------------------------
+    struct TraceQueue {
+        explicit TraceQueue(const size_t& capacity) : queue(capacity) {}
+        //--------------------------
+        SPSCQueue<TraceEvent> queue;
+        std::atomic<bool> closed{false}; // Set when the owning thread exits
+    }; // end struct TraceQueue
+    //--------------------------------------------------------------
+    // **Caps applied to every container printed by the *_STREAM calls, per nesting level**
+    //--------------------------------------------------------------
+    struct ContainerLimits {
+        size_t max_elements = 1024UL;           // Elements printed before "... (+N more)"
+        size_t max_bytes    = 64UL * 1024UL;    // Output bytes after which the rest is elided
+    }; // end struct ContainerLimits
+    //--------------------------------------------------------------
+    // **What a producer does in asynchronous mode when its ring is full**
+    //--------------------------------------------------------------
+    enum class Backpressure : uint8_t {
+        BLOCK               = 0, // Wait for the writer, nothing is lost
+        DROP_NEWEST         = 1, // Drop the record being logged
+        OVERWRITE_OLDEST    = 2, // Replace the oldest queued record if its level may be dropped, else drop the new one
+        SPIN_THEN_DROP      = 3  // Wait up to BackpressureOptions::spin, then drop the record being logged
+    }; // end enum class Backpressure : uint8_t
+    //--------------------------------------------------------------
+    struct BackpressureOptions {
+        Backpressure error                          = Backpressure::BLOCK;
+        Backpressure warning                        = Backpressure::BLOCK;
+        Backpressure info                           = Backpressure::BLOCK;
+        Backpressure debug                          = Backpressure::BLOCK;
+        std::chrono::microseconds spin              = std::chrono::microseconds(50);
+        std::chrono::milliseconds report_interval   = std::chrono::milliseconds(1000); // Drop summary period, 0 only reports on flush
+    }; // end struct BackpressureOptions
+    //--------------------------------------------------------------
+    class ScopeTimer;
     //--------------------------------------------------------------
     class Logger {
         //--------------------------------------------------------------
@@ -47,230 +123,730 @@ namespace Logger {
             //--------------------------
             template <typename T>
             static constexpr bool is_map_v = is_map<T>::value;
-            //--------------------------------------------------------------
-            enum class LogLevel : uint8_t {
-                DEBUG   = 1 << 0,
-                ERROR   = 1 << 1,
-                WARNING = 1 << 2,
-                INFO    = 1 << 3
-            }; // end enum class LogLevel : uint8_t
+            //--------------------------
+            template <typename T, typename = void>
+            struct is_tuple_like : std::false_type {};
+            //--------------------------
+            template <typename T>
+            struct is_tuple_like<T, std::void_t<decltype(std::tuple_size<T>::value)>> : std::true_type {};
+            //--------------------------
+            template <typename T>
+            static constexpr bool is_tuple_like_v = is_tuple_like<T>::value;
+            //--------------------------
+            template <typename T>
+            static constexpr bool is_string_v = std::is_convertible_v<const T&, std::string_view>;
             //--------------------------------------------------------------
         public:
+            //--------------------------------------------------------------
+            static constexpr size_t DEFAULT_QUEUE_CAPACITY = 1024UL; // Records per producer thread
             //--------------------------------------------------------------
             static Logger& instance(void);
             //--------------------------
+            // **Runtime level threshold, checked by the LOG_* macros before arguments are evaluated**
+            static void set_level(const LogLevel& minimum);
+            //--------------------------
+            static bool is_enabled(const LogLevel& level) {
+                return s_level_mask.load(std::memory_order_relaxed) & static_cast<uint8_t>(level);
+            } // end static bool is_enabled(const LogLevel& level)
+            //--------------------------
+            static bool is_enabled(const Category& category, const LogLevel& level) {
+                return category.is_enabled(level, s_level_mask.load(std::memory_order_relaxed));
+            } // end static bool is_enabled(const Category& category, const LogLevel& level)
+            //--------------------------
+            // **Per-subsystem thresholds, keyed by the tag passed to the LOG_*_TAG macros**
+            static Category& category(std::string_view name);
+            static void set_category_level(std::string_view name, const LogLevel& minimum);
+            static void reset_category_level(std::string_view name);
+            //--------------------------
+            // **Asynchronous mode: every producer thread enqueues into its own ring, a writer thread
+            // merges the rings by timestamp, formats and prints**
+            void start_async(const size_t& capacity = DEFAULT_QUEUE_CAPACITY);
+            void stop_async(void);
+            bool is_async(void) const;
+            //--------------------------
+            // **Blocks until every message logged before the call has been written**
+            void flush(void);
+            //--------------------------
+            // **Deferred formatting: in asynchronous mode, calls with a literal format string and
+            // arithmetic or string arguments only copy the raw argument bytes, the writer formats**
+            void set_deferred_formatting(const bool& enabled);
+            bool is_deferred_formatting(void) const;
+            //--------------------------
+            // **Sub-second digits of the timestamp prefix and the clock records are stamped with**
+            void set_timestamp_precision(const TimestampPrecision& precision);
+            bool set_clock_source(const ClockSource& source);
+            //--------------------------
+            // **Buffering, durability and rotation of error_log.txt and warning_log.txt**
+            void set_file_options(const FileSinkOptions& options);
+            //--------------------------
+            // **Batching, colors and stderr routing of the console output**
+            void set_console_options(const ConsoleSinkOptions& options);
+            //--------------------------
+            // **Collapses consecutive identical messages into one "Last message repeated" line per window, 0 disables**
+            void set_deduplication(const std::chrono::milliseconds& window);
+            //--------------------------
+            // **Per-level policy for full rings; drops are counted and written as a WARNING summary line**
+            void set_backpressure(const BackpressureOptions& options);
+            //--------------------------
+            // **Records of the level dropped or overwritten since start**
+            uint64_t dropped(const LogLevel& level) const;
+            //--------------------------
+            // **Self-instrumentation: per-thread counters, sink timings and a caller latency histogram**
+            // Off by default; while off, a log call pays one relaxed load for it.
+            void set_metrics(const MetricsOptions& options);
+            MetricsSnapshot metrics(void);
+            //--------------------------
+            // **Flight recorder: records of the chosen levels stay in a per-thread ring and are written
+            // only by a dump, ahead of an ERROR, on request or from the crash handler**
+            void set_flight_recorder(const FlightRecorderOptions& options);
+            //--------------------------
+            // **Writes the records not dumped yet, oldest first, to the sinks that take the route level**
+            void dump_flight_recorder(const FlightScope& scope = FlightScope::ALL_THREADS, const LogLevel& route = LogLevel::ERROR);
+            //--------------------------
+            // **Scope timing and trace marks: per-thread event buffers drained into the sinks that
+            // write traces, and optionally a WARNING for every LOG_SCOPE_TIMER scope over the threshold**
+            // Off by default; while off, LOG_SCOPE_TIMER and LOG_TRACE_* pay one relaxed load.
+            void set_tracing(const TraceOptions& options);
+            //--------------------------
+            static bool is_tracing(void) {
+                return s_trace_mask.load(std::memory_order_relaxed);
+            } // end static bool is_tracing(void)
+            //--------------------------
+            // **Called by LOG_TRACE_BEGIN and LOG_TRACE_END, name is a literal**
+            void trace_mark(const char* name, const TracePhase& phase);
+            //--------------------------
+            // **Called by LOG_SCOPE_TIMER when its scope ends**
+            void trace_scope(const char* name, const std::chrono::system_clock::time_point& begin, const std::source_location& location);
+            //--------------------------
+            // **Element and byte caps of the *_STREAM container output**
+            static void set_container_limits(const ContainerLimits& limits);
+            //--------------------------
+            // **Sink registry: every record goes to each sink whose levels include it, rendered once per formatter**
+            // The console (INFO and above, DEBUG too in DEBUG builds), error_log.txt (ERROR) and
+            // warning_log.txt (WARNING) are registered by default and can be removed or re-routed.
+            void add_sink(std::shared_ptr<Sink> sink, const SinkOptions& options = SinkOptions());
+            void remove_sink(const std::shared_ptr<Sink>& sink);
+            bool set_sink_options(const std::shared_ptr<Sink>& sink, const SinkOptions& options);
+            //--------------------------
+            std::shared_ptr<ConsoleSink> console_sink(void) const;
+            std::shared_ptr<FileSink> error_file_sink(void) const;
+            std::shared_ptr<FileSink> warning_file_sink(void) const;
+            //--------------------------
             template<typename... Args>
-            void debug(std::string_view format, Args&&... args) {
-                log(LogLevel::DEBUG, format, std::forward<Args>(args)...);
-            }// end void debug(std::string_view format, Args&&... args)
+            void debug(const FormatString& format, Args&&... args) {
+                if (is_enabled(LogLevel::DEBUG)) {
+                    log(LogLevel::DEBUG, format, std::forward<Args>(args)...);
+                } // end if (is_enabled(LogLevel::DEBUG))
+            }// end void debug(const FormatString& format, Args&&... args)
             //--------------------------
             template<typename... Args>
-            void error(std::string_view format, Args&&... args) {
-                log(LogLevel::ERROR, format, std::forward<Args>(args)...);
-            }// end void error(std::string_view format, Args&&... args)
+            void error(const FormatString& format, Args&&... args) {
+                if (is_enabled(LogLevel::ERROR)) {
+                    log(LogLevel::ERROR, format, std::forward<Args>(args)...);
+                } // end if (is_enabled(LogLevel::ERROR))
+            }// end void error(const FormatString& format, Args&&... args)
             //--------------------------
             template<typename... Args>
-            void warning(std::string_view format, Args&&... args) {
-                log(LogLevel::WARNING, format, std::forward<Args>(args)...);
-            } // end void warning(std::string_view format, Args&&... args)
+            void warning(const FormatString& format, Args&&... args) {
+                if (is_enabled(LogLevel::WARNING)) {
+                    log(LogLevel::WARNING, format, std::forward<Args>(args)...);
+                } // end if (is_enabled(LogLevel::WARNING))
+            } // end void warning(const FormatString& format, Args&&... args)
             //--------------------------
             template<typename... Args>
-            void info(std::string_view format, Args&&... args) {
-                log(LogLevel::INFO, format, std::forward<Args>(args)...);
-            } // end void info(std::string_view format, Args&&... args)
+            void info(const FormatString& format, Args&&... args) {
+                if (is_enabled(LogLevel::INFO)) {
+                    log(LogLevel::INFO, format, std::forward<Args>(args)...);
+                } // end if (is_enabled(LogLevel::INFO))
+            } // end void info(const FormatString& format, Args&&... args)
             //--------------------------
             template<typename T>
-            void debug_stream(std::string_view message, const T& container) {
-                log_stream(LogLevel::DEBUG, message, container);
-            } // end void debug_stream(std::string_view message, const T& container)
+            void debug_stream(std::string_view message, const T& container, const std::source_location& location = std::source_location::current()) {
+                if (is_enabled(LogLevel::DEBUG)) {
+                    log_stream(LogLevel::DEBUG, message, container, location);
+                } // end if (is_enabled(LogLevel::DEBUG))
+            } // end void debug_stream(std::string_view message, const T& container, const std::source_location& location)
             //--------------------------
             template<typename T>
-            void error_stream(std::string_view message, const T& container) {
-                log_stream(LogLevel::ERROR, message, container);
-            } // end void error_stream(std::string_view message, const T& container)
+            void error_stream(std::string_view message, const T& container, const std::source_location& location = std::source_location::current()) {
+                if (is_enabled(LogLevel::ERROR)) {
+                    log_stream(LogLevel::ERROR, message, container, location);
+                } // end if (is_enabled(LogLevel::ERROR))
+            } // end void error_stream(std::string_view message, const T& container, const std::source_location& location)
             //--------------------------
             template<typename T>
-            void warning_stream(std::string_view message, const T& container) {
-                log_stream(LogLevel::WARNING, message, container);
-            } // end void warning_stream(std::string_view message, const T& container)
+            void warning_stream(std::string_view message, const T& container, const std::source_location& location = std::source_location::current()) {
+                if (is_enabled(LogLevel::WARNING)) {
+                    log_stream(LogLevel::WARNING, message, container, location);
+                } // end if (is_enabled(LogLevel::WARNING))
+            } // end void warning_stream(std::string_view message, const T& container, const std::source_location& location)
             //--------------------------
             template<typename T>
-            void info_stream(std::string_view message, const T& container) {
-                log_stream(LogLevel::INFO, message, container);
-            } // end void info_stream(std::string_view message, const T& container)
+            void info_stream(std::string_view message, const T& container, const std::source_location& location = std::source_location::current()) {
+                if (is_enabled(LogLevel::INFO)) {
+                    log_stream(LogLevel::INFO, message, container, location);
+                } // end if (is_enabled(LogLevel::INFO))
+            } // end void info_stream(std::string_view message, const T& container, const std::source_location& location)
+            //--------------------------
+            // **Filtered by the category threshold instead of the global one**
+            template<typename... Args>
+            void tagged(const Category& category, const LogLevel& level, const FormatString& format, Args&&... args) {
+                if (is_enabled(category, level)) {
+                    log(level, format, std::forward<Args>(args)...);
+                } // end if (is_enabled(category, level))
+            } // end void tagged(const Category& category, const LogLevel& level, const FormatString& format, Args&&... args)
+            //--------------------------
+            template<typename T>
+            void tagged_stream(const Category& category, const LogLevel& level, std::string_view message, const T& container,
+                               const std::source_location& location = std::source_location::current()) {
+                if (is_enabled(category, level)) {
+                    log_stream(level, message, container, location);
+                } // end if (is_enabled(category, level))
+            } // end void tagged_stream(const Category& category, const LogLevel& level, std::string_view message, const T& container, ...)
+            //--------------------------
+            // **Structured record: message plus key, value pairs, see LOG_*_KV**
+            template<typename... Pairs>
+            void log_kv(KeyValueSite& site, const LogLevel& level, const FormatString& message, const Pairs&... pairs) {
+                //--------------------------
+                static_assert(sizeof...(Pairs) % 2UL == 0UL, "LOG_*_KV takes a message followed by key, value pairs");
+                //--------------------------
+                const auto now = clock_now();
+                site.prepare(pairs...);
+                //--------------------------
+                ScratchBuffer _fields;
+                KeyValueSite::encode_values(_fields.text(), pairs...);
+                //--------------------------
+                submit(level, now, message.view(), message.location(), &site, _fields.text());
+                //--------------------------
+            } // end void log_kv(KeyValueSite& site, const LogLevel& level, const FormatString& message, const Pairs&... pairs)
+            //--------------------------
+            // **Written by the rate-limited macros ahead of the first message that passes again**
+            void suppressed(const LogLevel& level, const uint64_t& count,
+                            const std::source_location& location = std::source_location::current()) {
+                log(level, FormatString("{} similar messages suppressed", true, location), count);
+            } // end void suppressed(const LogLevel& level, const uint64_t& count, const std::source_location& location)
             //--------------------------------------------------------------
         protected:
             //--------------------------------------------------------------
             template<typename... Args>
-            void log(const LogLevel& level, std::string_view format, Args&&... args) {
+            void log(const LogLevel& level, const FormatString& format, Args&&... args) {
                 //--------------------------
-                std::lock_guard<std::mutex> lock(m_mutex);
+                const auto now = clock_now();
                 //--------------------------
-                const auto now = std::chrono::system_clock::now();
+                if constexpr ((is_capturable_v<Args> && ...)) {
+                    const bool _recorded = is_recorded(level);
+                    if (format.is_static() && (_recorded || (m_deferred.load(std::memory_order_relaxed) &&
+                                                             m_async.load(std::memory_order_acquire)))) {
+                        CapturedArguments _arguments;
+                        if (capture(_arguments, args...)) {
+                            if (_recorded) {
+                                record_deferred(level, now, format, _arguments);
+                            } else {
+                                submit_deferred(level, now, format, _arguments);
+                            } // end if (_recorded)
+                            return;
+                        } // end if (capture(_arguments, args...))
+                    } // end if (format.is_static() && ...)
+                } // end if constexpr ((is_capturable_v<Args> && ...))
                 //--------------------------
+                // Steady state: formatted into the thread's scratch buffer, no allocation
+                ScratchBuffer _message;
 #if __cpp_lib_format
-                const std::string message = std::vformat(format, std::make_format_args(args...));
+                std::vformat_to(std::back_inserter(_message.text()), format.view(), std::make_format_args(args...));
 #else
-                const std::string message = fmt::format(fmt::runtime(format), std::forward<Args>(args)...);
+                fmt::format_to(std::back_inserter(_message.text()), fmt::runtime(format.view()), std::forward<Args>(args)...);
 #endif
                 //--------------------------
-                std::string _formatted_message = format_message(level, message, now);
-                //--------------------------
-                level_message(level, _formatted_message);
+                submit(level, now, _message.text(), format.location());
                 //--------------------------
-            }// end void log(LogLevel level, std::string_view format, Args&&... args)
+            }// end void log(const LogLevel& level, const FormatString& format, Args&&... args)
+            //--------------------------
+            // **Hands a formatted message to the writer thread or writes it under the lock**
+            void submit(const LogLevel& level, const std::chrono::system_clock::time_point& time, std::string_view message,
+                        const std::source_location& location, const KeyValueSite* site = nullptr, std::string_view fields = std::string_view());
+            //--------------------------
+            void submit_deferred(const LogLevel& level, const std::chrono::system_clock::time_point& time, const FormatString& format,
+                                 const CapturedArguments& arguments);
+            //--------------------------
+            // **Stores the record in the calling thread's flight recorder instead of writing it**
+            void record(const LogLevel& level, const std::chrono::system_clock::time_point& time, std::string_view message,
+                        const std::source_location& location, const KeyValueSite* site, std::string_view fields);
+            //--------------------------
+            // **As record(), keeping the arguments for later formatting; format must be a literal**
+            void record_deferred(const LogLevel& level, const std::chrono::system_clock::time_point& time, const FormatString& format,
+                                 const CapturedArguments& arguments);
+            //--------------------------
+            bool is_recorded(const LogLevel& level) const {
+                return m_flight_levels.load(std::memory_order_relaxed) & static_cast<uint8_t>(level);
+            } // end bool is_recorded(const LogLevel& level) const
+            //--------------------------
+            std::chrono::system_clock::time_point clock_now(void) const {
+                return m_clock_source.load(std::memory_order_relaxed) == ClockSource::TSC ? TscClock::now() : std::chrono::system_clock::now();
+            } // end std::chrono::system_clock::time_point clock_now(void) const
+            //--------------------------
+            void dispatch(LogRecord& record);
+            //--------------------------
+            // **Writes to the sinks that take the route level, the record's own level when route is 0**
+            void write_record(const LogRecord& record, const uint8_t& route = 0U);
+            //--------------------------
+            bool collapse(const LogRecord& record);
+            //--------------------------
+            void flush_repeats(void);
+            //--------------------------
+            // **Slot of the formatter in m_formatters, added when new; null is the standard text line**
+            size_t formatter_slot(const std::shared_ptr<Formatter>& formatter);
+            //--------------------------
+            // **Drops formatters no sink uses anymore**
+            void compact_formatters(void);
+            //--------------------------
+            void flush_files(void);
+            //--------------------------
+            // **Tells every sink whether a writer thread polls it, m_mutex held**
+            void set_batching(const bool& enabled);
+            //--------------------------
+            // **The calling thread's next free ring slot; when the ring is full the level's backpressure
+            // policy decides, nullptr means the record is dropped**
+            LogRecord* claim(ThreadQueue& queue, const LogLevel& level);
+            //--------------------------
+            // **Writes "Dropped N records ..." for the drops since the last summary, m_mutex held**
+            void report_drops(void);
+            //--------------------------
+            // **The calling thread's metrics shard, registered on first use**
+            MetricsShard& local_shard(void);
+            //--------------------------
+            // **Locks m_mutex, timing the wait when it is contended and metrics are on**
+            void lock_metered(std::unique_lock<std::mutex>& lock);
+            //--------------------------
+            // **Counts a call and its latency from the record timestamp to now**
+            void meter_call(const LogLevel& level, const std::chrono::system_clock::time_point& time);
+            //--------------------------
+            // **Snapshot with m_mutex held**
+            void collect_metrics(MetricsSnapshot& snapshot);
+            //--------------------------
+            // **Rewrites the Prometheus file when the dump interval has passed, m_mutex held**
+            void dump_metrics(void);
+            //--------------------------
+            // **Appends to the calling thread's trace buffer; a full buffer is drained by its own thread**
+            void push_trace(const TraceEvent& event);
+            //--------------------------
+            // **Hands every buffered trace event to the sinks, m_mutex held**
+            void drain_traces(void);
             //--------------------------
-            void level_message(const LogLevel& level, std::string_view message) const;
+            TraceQueue& local_trace_queue(void);
             //--------------------------
-            constexpr std::string_view level_print(const LogLevel& level) const;
+            // **The calling thread's flight recorder, registered on first use**
+            FlightRecorder& local_recorder(void);
             //--------------------------
-            std::string format_message(const LogLevel& level, std::string_view message, const std::chrono::system_clock::time_point& now) const;
+            // **Dump with m_mutex held; dump_flight_recorder() and the synchronous ERROR path end here**
+            void dump_flight(const FlightScope& scope, const LogLevel& route);
             //--------------------------
-            void log_file(const std::string& filename, std::string_view message) const;
+            // **Dump the writer emits ahead of a queued ERROR, up to what its thread had recorded; m_mutex held**
+            void dump_flight(const LogRecord& record);
+            //--------------------------
+            // **Writes the records before last, all recorded ones by default**
+            void dump_recorder(FlightRecorder& recorder, const LogLevel& route, const uint64_t& last = UINT64_MAX);
+            //--------------------------
+            // **The calling thread's ring marked as producing, null once asynchronous mode has stopped;
+            // leave_queue() ends the enqueue**
+            ThreadQueue* enter_queue(void);
+            //--------------------------
+            static void leave_queue(ThreadQueue& queue) {
+                queue.producing.store(false, std::memory_order_release);
+            } // end static void leave_queue(ThreadQueue& queue)
+            //--------------------------
+            // **Flags a claimed record for the writer to dump the flight recorder ahead of it**
+            void mark_flight(LogRecord& record, const bool& dump);
+            //--------------------------
+            void publish(ThreadQueue& queue);
+            //--------------------------
+            void wake_writer(void);
+            //--------------------------
+            void writer_loop(void);
+            //--------------------------
+            size_t drain_queue(void);
+            //--------------------------
+            ThreadQueue& local_queue(void);
+            //--------------------------
+            static uint64_t thread_id(void);
             //--------------------------
             template<typename T>
-            void log_stream(const LogLevel& level, std::string_view message, const T& container) {
-                //--------------------------
-                std::lock_guard<std::mutex> lock(m_mutex);
+            void log_stream(const LogLevel& level, std::string_view message, const T& container, const std::source_location& location) {
                 //--------------------------
-                const auto now = std::chrono::system_clock::now();
+                const auto now = clock_now();
                 //--------------------------
-                const std::string container_str       = print_container(container);
-                const std::string combined_message    = std::string(message) + " " + container_str;
-                const std::string _formatted_message  = format_message(level, combined_message, now);
+                ScratchBuffer _message;
+                _message.text().append(message).push_back(' ');
+                print_container(_message.text(), container);
                 //--------------------------
-                level_message(level, _formatted_message);
+                submit(level, now, _message.text(), location);
                 //--------------------------
-            }// end void log_stream(LogLevel level, std::string_view message, const T& container)
+            }// end void log_stream(const LogLevel& level, std::string_view message, const T& container, const std::source_location& location)
             //--------------------------
             template<typename T>
-            std::string print_container(const T& container) const {
-                if constexpr (is_map_v<T>) {
-                    return print_map(container);
+            void print_container(std::string& output, const T& container) const {
+                if constexpr (is_string_v<T>) {
+                    print_element(output, container);
+                } else if constexpr (is_map_v<T>) {
+                    print_map(output, container);
                 } else if constexpr (is_container_v<T>) {
-                    return print_general_container(container);
+                    print_general_container(output, container);
+                } else if constexpr (is_tuple_like_v<T>) {
+                    print_tuple(output, container);
                 } else if constexpr (std::is_enum_v<T>) {
-                    return print_enum(container);
+                    print_enum(output, container);
                 } else {
-                    return print_element(container);
-                } // end if constexpr (is_map_v<T>)
-            }// end std::string print_container(const T& container)
+                    print_element(output, container);
+                } // end if constexpr (is_string_v<T>)
+            }// end void print_container(std::string& output, const T& container)
             //--------------------------
             template<typename T>
-            std::string print_map(const T& container) const {
-#if __cpp_lib_format
-                std::string result = std::format("{{");
-                for (const auto& [key, value] : container) {
-                    result += std::format("{{{}: {}}}, ", key, value);
-                } // end for(const auto& [key, value] : container)
-#else
-                std::string result = fmt::format("{{");
-                for (const auto& [key, value] : container) {
-                    result += fmt::format("{{{}: {}}}, ", key, value);
-                } // end for(const auto& [key, value] : container)
-#endif
+            void print_map(std::string& output, const T& container) const {
                 //--------------------------
-                if (result.size() > 3) { // Remove trailing ", " if present
-                    result.erase(result.size() - 2, 2);
-                } // end if (result.size() > 3)
+                output.push_back('{');
+                print_elements(output, container, [this](std::string& out, const auto& entry) {
+                    out.push_back('{');
+                    print_container(out, entry.first);
+                    out.append(": ");
+                    print_container(out, entry.second);
+                    out.push_back('}');
+                });
+                output.push_back('}');
                 //--------------------------
-                result += "}";
-                //--------------------------
-                return result;
-            } // end std::string print_map(const T& container)
+            } // end void print_map(std::string& output, const T& container)
             //--------------------------
             template<typename T>
-            std::string print_general_container(const T& container) const {
-#if __cpp_lib_format
-                std::string result = std::format("[");
-                for (const auto& element : container) {
-                    result += std::format("{}, ", element);
-                } // end for(const auto& element : container)
-#else
-                std::string result = fmt::format("[");
-                for (const auto& element : container) {
-                    result += fmt::format("{}, ", element);
-                } // end for(const auto& element : container)
-#endif
+            void print_general_container(std::string& output, const T& container) const {
+                //--------------------------
+                output.push_back('[');
+                print_elements(output, container, [this](std::string& out, const auto& element) {
+                    print_container(out, element);
+                });
+                output.push_back(']');
+                //--------------------------
+            } // end void print_general_container(std::string& output, const T& container)
+            //--------------------------
+            // **Comma-separated elements up to the element and byte caps, then "... (+N more)"**
+            template<typename T, typename Print>
+            void print_elements(std::string& output, const T& container, Print&& print) const {
                 //--------------------------
-                if (result.size() > 2) { // Remove trailing ", " if present
-                    result.erase(result.size() - 2, 2);
-                } // end if (result.size() > 2)
+                const size_t _max_elements  = s_max_elements.load(std::memory_order_relaxed);
+                const size_t _max_bytes     = s_max_bytes.load(std::memory_order_relaxed);
+                const size_t _start         = output.size();
                 //--------------------------
-                result += "]";
+                size_t _count   = 0UL;
+                auto _iterator  = std::begin(container);
+                const auto _end = std::end(container);
                 //--------------------------
-                return result;
-            } // end std::string print_general_container(const T& container)
+                for (; _iterator != _end; ++_iterator, ++_count) {
+                    //--------------------------
+                    if (_count >= _max_elements || output.size() - _start >= _max_bytes) {
+                        break;
+                    } // end if (_count >= _max_elements || output.size() - _start >= _max_bytes)
+                    //--------------------------
+                    if (_count) {
+                        output.append(", ");
+                    } // end if (_count)
+                    print(output, *_iterator);
+                    //--------------------------
+                } // end for (; _iterator != _end; ++_iterator, ++_count)
+                //--------------------------
+                if (_iterator == _end) {
+                    return;
+                } // end if (_iterator == _end)
+                //--------------------------
+                size_t _remaining;
+                if constexpr (requires { container.size(); }) {
+                    _remaining = static_cast<size_t>(container.size()) - _count;
+                } else {
+                    _remaining = static_cast<size_t>(std::distance(_iterator, _end));
+                } // end if constexpr (requires { container.size(); })
+                //--------------------------
+                output.append(_count ? ", ... (+" : "... (+");
+                print_element(output, _remaining);
+                output.append(" more)");
+                //--------------------------
+            } // end void print_elements(std::string& output, const T& container, Print&& print)
             //--------------------------
+            // **Pairs and tuples outside of maps: (a, b, ...)**
             template<typename T>
-            std::string print_enum(const T& element) const {
-#if __cpp_lib_format
-                return std::format("{}", static_cast<std::underlying_type_t<T>>(element));
-#else
-                return fmt::format("{}", static_cast<std::underlying_type_t<T>>(element));
-#endif
-            } // end std::string print_enum(const T& element)
+            void print_tuple(std::string& output, const T& tuple) const {
+                //--------------------------
+                output.push_back('(');
+                std::apply([this, &output](const auto&... elements) {
+                    size_t _index = 0UL;
+                    ((output.append(_index++ ? ", " : ""), print_container(output, elements)), ...);
+                }, tuple);
+                output.push_back(')');
+                //--------------------------
+            } // end void print_tuple(std::string& output, const T& tuple)
             //--------------------------
             template<typename T>
-            std::string print_element(const T& element) const {
+            void print_enum(std::string& output, const T& element) const {
+                print_element(output, static_cast<std::underlying_type_t<T>>(element));
+            } // end void print_enum(std::string& output, const T& element)
+            //--------------------------
+            template<typename T>
+            void print_element(std::string& output, const T& element) const {
 #if __cpp_lib_format
-                return std::format("{}", element);
+                std::format_to(std::back_inserter(output), "{}", element);
 #else
-                return fmt::format("{}", element);
+                fmt::format_to(std::back_inserter(output), "{}", element);
 #endif
-            }
+            } // end void print_element(std::string& output, const T& element)
             //--------------------------------------------------------------
         private:
             //--------------------------------------------------------------
-            Logger(void)                        = default;
-            ~Logger(void)                       = default;
+            Logger(void);
+            ~Logger(void);
             //--------------------------
             Logger(const Logger&)               = delete;
             Logger& operator=(const Logger&)    = delete;
             Logger(Logger&&)                    = delete;
             Logger& operator=(Logger&&)         = delete;
             //--------------------------
+            // Reads the buffers and rings without locking when the process is going down
+            friend class CrashHandler;
+            // Stamps scopes with clock_now()
+            friend class ScopeTimer;
+            //--------------------------
             std::mutex m_mutex;
+            //--------------------------
+            // Registry, guarded by m_mutex
+            struct SinkEntry {
+                std::shared_ptr<Sink> sink;
+                uint8_t levels;
+                size_t formatter;   // Index into m_formatters
+                SinkMetrics metrics;
+            }; // end struct SinkEntry
+            //--------------------------
+            struct FormatterSlot {
+                std::shared_ptr<Formatter> formatter;
+                std::string line;   // Output for the record being written, capacity kept
+                bool ready;
+            }; // end struct FormatterSlot
+            //--------------------------
+            std::vector<SinkEntry> m_sinks;
+            std::vector<FormatterSlot> m_formatters; // [0] is the standard text line
+            //--------------------------
+            // Default sinks, kept for their options and the crash handler even when removed
+            const std::shared_ptr<ConsoleSink> m_console;
+            const std::shared_ptr<FileSink> m_error_file;
+            const std::shared_ptr<FileSink> m_warning_file;
+            //--------------------------
+            // Reused for synchronous records, guarded by m_mutex
+            LogRecord m_record;
+            //--------------------------
+            // Backpressure: policies and spin read by producers, counters bumped by them
+            std::array<std::atomic<Backpressure>, LEVEL_COUNT> m_backpressure{};
+            std::atomic<int64_t> m_spin_nanoseconds{BackpressureOptions().spin.count() * 1000L};
+            std::atomic<int64_t> m_report_milliseconds{BackpressureOptions().report_interval.count()};
+            std::array<std::atomic<uint64_t>, LEVEL_COUNT> m_dropped{};
+            std::array<uint64_t, LEVEL_COUNT> m_dropped_reported{}; // Guarded by m_mutex
+            std::chrono::steady_clock::time_point m_next_drop_report; // Writer thread only
+            //--------------------------
+            // Metrics: shards are written by their threads, the rest is guarded by m_mutex
+            std::atomic<bool> m_metrics_enabled{false};
+            std::array<uint64_t, LEVEL_COUNT> m_bytes{};
+            uint64_t m_queue_high_water{0UL};
+            uint64_t m_sink_sequence{0UL};          // Numbers unnamed sinks
+            std::string m_metrics_file;
+            std::chrono::milliseconds m_metrics_interval{MetricsOptions().dump_interval};
+            std::chrono::steady_clock::time_point m_next_metrics_dump;
+            //--------------------------
+            std::mutex m_shards_mutex;
+            std::vector<std::shared_ptr<MetricsShard>> m_shards;
+            MetricsSnapshot m_retired;              // Shards of exited threads, guarded by m_shards_mutex
+            //--------------------------
+            // Flight recorder: settings read by producers, each recorder guarded by its own mutex
+            std::atomic<uint8_t> m_flight_levels{0U};
+            std::atomic<bool> m_flight_on_error{false};
+            std::atomic<FlightScope> m_flight_scope{FlightScope::THREAD};
+            std::atomic<size_t> m_flight_capacity{FlightRecorderOptions().capacity};
+            std::atomic<size_t> m_flight_dump_records{FlightRecorderOptions().dump_records};
+            //--------------------------
+            std::mutex m_recorders_mutex;
+            std::vector<std::shared_ptr<FlightRecorder>> m_recorders;
+            //--------------------------
+            // Tracing: s_trace_mask bits, the rest read by the tracing threads
+            static constexpr uint8_t TRACE_EVENTS   = 1U << 0U;
+            static constexpr uint8_t TRACE_SLOW     = 1U << 1U;
+            std::atomic<int64_t> m_trace_threshold_nanoseconds{0L};
+            std::atomic<size_t> m_trace_capacity{TraceOptions().capacity};
+            //--------------------------
+            std::mutex m_trace_queues_mutex;
+            std::vector<std::shared_ptr<TraceQueue>> m_trace_queues;
+            //--------------------------
+            // Duplicate collapsing, guarded by m_mutex
+            std::chrono::milliseconds m_dedup_window{0};
+            std::string m_last_message;
+            std::string m_last_fields;
+            size_t m_last_hash{0UL};
+            LogLevel m_last_level{LogLevel::INFO};
+            uint64_t m_repeats{0UL};
+            std::chrono::system_clock::time_point m_first_repeat;
+            std::chrono::system_clock::time_point m_last_repeat;
+            //--------------------------
+            std::mutex m_queues_mutex;
+            std::vector<std::shared_ptr<ThreadQueue>> m_queues;
+            std::atomic<uint64_t> m_queues_version{0UL};
+            std::atomic<size_t> m_queue_capacity{DEFAULT_QUEUE_CAPACITY};
+            //--------------------------
+            // Owned by whoever drains: the writer thread, or stop_async() after joining it
+            std::vector<std::shared_ptr<ThreadQueue>> m_drain_queues;
+            std::vector<std::pair<std::chrono::system_clock::time_point, size_t>> m_drain_heap;
+            uint64_t m_drain_version{0UL};
+            //--------------------------
+            std::thread m_writer;
+            std::mutex m_control_mutex;
+            std::atomic<bool> m_async{false};
+            std::atomic<bool> m_running{false};
+            std::atomic<bool> m_deferred{false};
+            std::atomic<ClockSource> m_clock_source{ClockSource::SYSTEM};
+            //--------------------------
+            static inline std::atomic<uint8_t> s_level_mask{level_mask(LogLevel::DEBUG)};
+            static inline std::atomic<size_t> s_max_elements{ContainerLimits().max_elements};
+            static inline std::atomic<size_t> s_max_bytes{ContainerLimits().max_bytes};
+            static inline std::atomic<uint8_t> s_trace_mask{0U};
+            //--------------------------
+            std::mutex m_writer_mutex;
+            std::condition_variable m_writer_cv;
+            std::atomic<bool> m_writer_idle{false};
+            //--------------------------
+            std::mutex m_flush_mutex;
+            std::condition_variable m_flush_cv;
+            std::atomic<uint64_t> m_flush_requested{0UL};
+            std::atomic<uint64_t> m_flush_completed{0UL};
         //--------------------------------------------------------------
     }; // end class Logger
     //--------------------------------------------------------------
+    // **Times the enclosing scope for LOG_SCOPE_TIMER**
+    //--------------------------------------------------------------
+    class ScopeTimer {
+        //--------------------------------------------------------------
+        public:
+            //--------------------------------------------------------------
+            explicit ScopeTimer(const char* name, const std::source_location& location = std::source_location::current()) :
+                m_name(name), m_location(location), m_active(Logger::is_tracing()) {
+                //--------------------------
+                if (LOGGER_UNLIKELY(m_active)) {
+                    m_begin = Logger::instance().clock_now();
+                } // end if (LOGGER_UNLIKELY(m_active))
+                //--------------------------
+            } // end explicit ScopeTimer(const char* name, const std::source_location& location)
+            //--------------------------
+            ~ScopeTimer(void) {
+                if (LOGGER_UNLIKELY(m_active)) {
+                    Logger::instance().trace_scope(m_name, m_begin, m_location);
+                } // end if (LOGGER_UNLIKELY(m_active))
+            } // end ~ScopeTimer(void)
+            //--------------------------
+            ScopeTimer(const ScopeTimer&)               = delete;
+            ScopeTimer& operator=(const ScopeTimer&)    = delete;
+            ScopeTimer(ScopeTimer&&)                    = delete;
+            ScopeTimer& operator=(ScopeTimer&&)         = delete;
+            //--------------------------------------------------------------
+        private:
+            //--------------------------------------------------------------
+            const char* m_name;
+            std::source_location m_location;
+            std::chrono::system_clock::time_point m_begin;
+            const bool m_active;
+        //--------------------------------------------------------------
+    }; // end class ScopeTimer
+    //--------------------------------------------------------------
 } // end namespace Logger
 //--------------------------------------------------------------
-// Existing logging macros
-//--------------------------------------------------------------
-#define LOG_ERROR(msg, ...) Logger::Logger::instance().error(msg, ##__VA_ARGS__)
-#define LOG_WARNING(msg, ...) Logger::Logger::instance().warning(msg, ##__VA_ARGS__)
-#define LOG_INFO(msg, ...) Logger::Logger::instance().info(msg, ##__VA_ARGS__)
-#define LOG_ERROR_STREAM(msg, container) Logger::Logger::instance().error_stream(msg, container)
-#define LOG_WARNING_STREAM(msg, container) Logger::Logger::instance().warning_stream(msg, container)
-#define LOG_INFO_STREAM(msg, container) Logger::Logger::instance().info_stream(msg, container)
-//--------------------------------------------------------------
 // **Helper macros for unique variable names using __LINE__**
 //--------------------------------------------------------------
 #define CONCATENATE_DETAIL(x, y) x##y
 #define CONCATENATE(x, y) CONCATENATE_DETAIL(x, y)
 #define UNIQUE_VAR(base) CONCATENATE(base, __LINE__)
 //--------------------------------------------------------------
+// **Level gates: a relaxed load before any argument is evaluated**
+//--------------------------------------------------------------
+#define LOG_IF_ENABLED(level, statement) do { \
+    if (LOGGER_UNLIKELY(!Logger::Logger::is_enabled(Logger::LogLevel::level))) break; \
+    statement; \
+} while(0)
+
+#define LOG_TAG(tag, level, msg, ...) do { \
+    static Logger::Category& UNIQUE_VAR(log_category_) = Logger::Logger::category(tag); \
+    if (LOGGER_UNLIKELY(!Logger::Logger::is_enabled(UNIQUE_VAR(log_category_), Logger::LogLevel::level))) break; \
+    Logger::Logger::instance().tagged(UNIQUE_VAR(log_category_), Logger::LogLevel::level, LOGGER_FORMAT(msg), ##__VA_ARGS__); \
+} while(0)
+
+#define LOG_TAG_STREAM(tag, level, msg, container) do { \
+    static Logger::Category& UNIQUE_VAR(log_category_) = Logger::Logger::category(tag); \
+    if (LOGGER_UNLIKELY(!Logger::Logger::is_enabled(UNIQUE_VAR(log_category_), Logger::LogLevel::level))) break; \
+    Logger::Logger::instance().tagged_stream(UNIQUE_VAR(log_category_), Logger::LogLevel::level, msg, container); \
+} while(0)
+//--------------------------------------------------------------
+// Existing logging macros
+//--------------------------------------------------------------
+#if LOGGER_MIN_LEVEL <= LOGGER_LEVEL_ERROR
+    #define LOG_ERROR(msg, ...) LOG_IF_ENABLED(ERROR, Logger::Logger::instance().error(LOGGER_FORMAT(msg), ##__VA_ARGS__))
+    #define LOG_ERROR_STREAM(msg, container) LOG_IF_ENABLED(ERROR, Logger::Logger::instance().error_stream(msg, container))
+    #define LOG_ERROR_TAG(tag, msg, ...) LOG_TAG(tag, ERROR, msg, ##__VA_ARGS__)
+    #define LOG_ERROR_TAG_STREAM(tag, msg, container) LOG_TAG_STREAM(tag, ERROR, msg, container)
+#else
+    #define LOG_ERROR(msg, ...)
+    #define LOG_ERROR_STREAM(msg, container)
+    #define LOG_ERROR_TAG(tag, msg, ...)
+    #define LOG_ERROR_TAG_STREAM(tag, msg, container)
+#endif
+//--------------------------
+#if LOGGER_MIN_LEVEL <= LOGGER_LEVEL_WARNING
+    #define LOG_WARNING(msg, ...) LOG_IF_ENABLED(WARNING, Logger::Logger::instance().warning(LOGGER_FORMAT(msg), ##__VA_ARGS__))
+    #define LOG_WARNING_STREAM(msg, container) LOG_IF_ENABLED(WARNING, Logger::Logger::instance().warning_stream(msg, container))
+    #define LOG_WARNING_TAG(tag, msg, ...) LOG_TAG(tag, WARNING, msg, ##__VA_ARGS__)
+    #define LOG_WARNING_TAG_STREAM(tag, msg, container) LOG_TAG_STREAM(tag, WARNING, msg, container)
+#else
+    #define LOG_WARNING(msg, ...)
+    #define LOG_WARNING_STREAM(msg, container)
+    #define LOG_WARNING_TAG(tag, msg, ...)
+    #define LOG_WARNING_TAG_STREAM(tag, msg, container)
+#endif
+//--------------------------
+#if LOGGER_MIN_LEVEL <= LOGGER_LEVEL_INFO
+    #define LOG_INFO(msg, ...) LOG_IF_ENABLED(INFO, Logger::Logger::instance().info(LOGGER_FORMAT(msg), ##__VA_ARGS__))
+    #define LOG_INFO_STREAM(msg, container) LOG_IF_ENABLED(INFO, Logger::Logger::instance().info_stream(msg, container))
+    #define LOG_INFO_TAG(tag, msg, ...) LOG_TAG(tag, INFO, msg, ##__VA_ARGS__)
+    #define LOG_INFO_TAG_STREAM(tag, msg, container) LOG_TAG_STREAM(tag, INFO, msg, container)
+#else
+    #define LOG_INFO(msg, ...)
+    #define LOG_INFO_STREAM(msg, container)
+    #define LOG_INFO_TAG(tag, msg, ...)
+    #define LOG_INFO_TAG_STREAM(tag, msg, container)
+#endif
+//--------------------------------------------------------------
 // **Logging macros for conditional logging with DEBUG**
+// LOGGER_FLIGHT_RECORDER keeps them in release builds, for the flight recorder to hold.
 //--------------------------------------------------------------
-#ifdef LOGGER_DEBUG
-    #define LOG_DEBUG(msg, ...) Logger::Logger::instance().debug(msg, ##__VA_ARGS__)
-    #define LOG_DEBUG_STREAM(msg, container) Logger::Logger::instance().debug_stream(msg, container)
-    //--------------------------
-    // **Newly added macros**
-    #define LOG_WARNING_DEBUG(msg, ...) Logger::Logger::instance().warning(msg, ##__VA_ARGS__)
-    #define LOG_WARNING_DEBUG_STREAM(msg, container) Logger::Logger::instance().warning_stream(msg, container)
-    //--------------------------
-    #define LOG_ERROR_DEBUG(msg, ...) Logger::Logger::instance().error(msg, ##__VA_ARGS__)
-    #define LOG_ERROR_DEBUG_STREAM(msg, container) Logger::Logger::instance().error_stream(msg, container)
+#if (defined(LOGGER_DEBUG) || defined(LOGGER_FLIGHT_RECORDER)) && LOGGER_MIN_LEVEL <= LOGGER_LEVEL_DEBUG
+    #define LOG_DEBUG(msg, ...) LOG_IF_ENABLED(DEBUG, Logger::Logger::instance().debug(LOGGER_FORMAT(msg), ##__VA_ARGS__))
+    #define LOG_DEBUG_STREAM(msg, container) LOG_IF_ENABLED(DEBUG, Logger::Logger::instance().debug_stream(msg, container))
+    #define LOG_DEBUG_TAG(tag, msg, ...) LOG_TAG(tag, DEBUG, msg, ##__VA_ARGS__)
+    #define LOG_DEBUG_TAG_STREAM(tag, msg, container) LOG_TAG_STREAM(tag, DEBUG, msg, container)
 #else
     #define LOG_DEBUG(msg, ...)
     #define LOG_DEBUG_STREAM(msg, container)
-    //--------------------------
+    #define LOG_DEBUG_TAG(tag, msg, ...)
+    #define LOG_DEBUG_TAG_STREAM(tag, msg, container)
+#endif
+//--------------------------
+#if defined(LOGGER_DEBUG) && LOGGER_MIN_LEVEL <= LOGGER_LEVEL_WARNING
+    #define LOG_WARNING_DEBUG(msg, ...) LOG_WARNING(msg, ##__VA_ARGS__)
+    #define LOG_WARNING_DEBUG_STREAM(msg, container) LOG_WARNING_STREAM(msg, container)
+#else
     // **Ensure macros do nothing when DEBUG is not defined**
     #define LOG_WARNING_DEBUG(msg, ...)
     #define LOG_WARNING_DEBUG_STREAM(msg, container)
-    //--------------------------
+#endif
+//--------------------------
+#if defined(LOGGER_DEBUG) && LOGGER_MIN_LEVEL <= LOGGER_LEVEL_ERROR
+    #define LOG_ERROR_DEBUG(msg, ...) LOG_ERROR(msg, ##__VA_ARGS__)
+    #define LOG_ERROR_DEBUG_STREAM(msg, container) LOG_ERROR_STREAM(msg, container)
+#else
     #define LOG_ERROR_DEBUG(msg, ...)
     #define LOG_ERROR_DEBUG_STREAM(msg, container)
 #endif
@@ -281,7 +857,7 @@ namespace Logger {
 #define LOG_ONCE(level_method, msg, ...) do { \
     static std::once_flag UNIQUE_VAR(log_once_flag_); \
     std::call_once(UNIQUE_VAR(log_once_flag_), [&]{ \
-        Logger::Logger::instance().level_method(msg, ##__VA_ARGS__); \
+        Logger::Logger::instance().level_method(LOGGER_FORMAT(msg), ##__VA_ARGS__); \
     }); \
 } while(0)
 
@@ -293,19 +869,151 @@ namespace Logger {
 } while(0)
 
 // **Define macros for each log level**
-#define LOG_ERROR_ONCE(msg, ...) LOG_ONCE(error, msg, ##__VA_ARGS__)
-#define LOG_WARNING_ONCE(msg, ...) LOG_ONCE(warning, msg, ##__VA_ARGS__)
-#define LOG_INFO_ONCE(msg, ...) LOG_ONCE(info, msg, ##__VA_ARGS__)
+#if LOGGER_MIN_LEVEL <= LOGGER_LEVEL_ERROR
+    #define LOG_ERROR_ONCE(msg, ...) LOG_IF_ENABLED(ERROR, LOG_ONCE(error, msg, ##__VA_ARGS__))
+    #define LOG_ERROR_ONCE_STREAM(msg, container) LOG_IF_ENABLED(ERROR, LOG_ONCE_STREAM(error, msg, container))
+#else
+    #define LOG_ERROR_ONCE(msg, ...)
+    #define LOG_ERROR_ONCE_STREAM(msg, container)
+#endif
 
-#define LOG_ERROR_ONCE_STREAM(msg, container) LOG_ONCE_STREAM(error, msg, container)
-#define LOG_WARNING_ONCE_STREAM(msg, container) LOG_ONCE_STREAM(warning, msg, container)
-#define LOG_INFO_ONCE_STREAM(msg, container) LOG_ONCE_STREAM(info, msg, container)
+#if LOGGER_MIN_LEVEL <= LOGGER_LEVEL_WARNING
+    #define LOG_WARNING_ONCE(msg, ...) LOG_IF_ENABLED(WARNING, LOG_ONCE(warning, msg, ##__VA_ARGS__))
+    #define LOG_WARNING_ONCE_STREAM(msg, container) LOG_IF_ENABLED(WARNING, LOG_ONCE_STREAM(warning, msg, container))
+#else
+    #define LOG_WARNING_ONCE(msg, ...)
+    #define LOG_WARNING_ONCE_STREAM(msg, container)
+#endif
 
-#ifdef LOGGER_DEBUG
-    #define LOG_DEBUG_ONCE(msg, ...) LOG_ONCE(debug, msg, ##__VA_ARGS__)
-    #define LOG_DEBUG_ONCE_STREAM(msg, container) LOG_ONCE_STREAM(debug, msg, container)
+#if LOGGER_MIN_LEVEL <= LOGGER_LEVEL_INFO
+    #define LOG_INFO_ONCE(msg, ...) LOG_IF_ENABLED(INFO, LOG_ONCE(info, msg, ##__VA_ARGS__))
+    #define LOG_INFO_ONCE_STREAM(msg, container) LOG_IF_ENABLED(INFO, LOG_ONCE_STREAM(info, msg, container))
+#else
+    #define LOG_INFO_ONCE(msg, ...)
+    #define LOG_INFO_ONCE_STREAM(msg, container)
+#endif
+
+#if (defined(LOGGER_DEBUG) || defined(LOGGER_FLIGHT_RECORDER)) && LOGGER_MIN_LEVEL <= LOGGER_LEVEL_DEBUG
+    #define LOG_DEBUG_ONCE(msg, ...) LOG_IF_ENABLED(DEBUG, LOG_ONCE(debug, msg, ##__VA_ARGS__))
+    #define LOG_DEBUG_ONCE_STREAM(msg, container) LOG_IF_ENABLED(DEBUG, LOG_ONCE_STREAM(debug, msg, container))
 #else
     #define LOG_DEBUG_ONCE(msg, ...)
     #define LOG_DEBUG_ONCE_STREAM(msg, container)
 #endif
-//--------------------------------------------------------------
\ No newline at end of file
+//--------------------------------------------------------------
+// **Sampling and rate limiting per call site: suppressed calls skip argument evaluation**
+//--------------------------------------------------------------
+#define LOG_EVERY_N(n, statement) do { \
+    static Logger::EveryN UNIQUE_VAR(log_every_n_)(n); \
+    if (LOGGER_LIKELY(!UNIQUE_VAR(log_every_n_).should_log())) break; \
+    statement; \
+} while(0)
+
+#define LOG_LIMITED(level, limiter, statement) do { \
+    static auto UNIQUE_VAR(log_limiter_) = limiter; \
+    uint64_t UNIQUE_VAR(log_suppressed_) = 0; \
+    if (LOGGER_LIKELY(!UNIQUE_VAR(log_limiter_).should_log(UNIQUE_VAR(log_suppressed_)))) break; \
+    if (UNIQUE_VAR(log_suppressed_)) { \
+        Logger::Logger::instance().suppressed(Logger::LogLevel::level, UNIQUE_VAR(log_suppressed_)); \
+    } \
+    statement; \
+} while(0)
+
+#define LOG_EVERY_MS(level, ms, statement) \
+    LOG_LIMITED(level, Logger::EveryInterval(std::chrono::milliseconds(ms)), statement)
+
+#define LOG_RATE(level, per_second, burst, statement) \
+    LOG_LIMITED(level, Logger::TokenBucket(per_second, burst), statement)
+
+#if LOGGER_MIN_LEVEL <= LOGGER_LEVEL_ERROR
+    #define LOG_ERROR_EVERY_N(n, msg, ...) LOG_IF_ENABLED(ERROR, LOG_EVERY_N(n, Logger::Logger::instance().error(LOGGER_FORMAT(msg), ##__VA_ARGS__)))
+    #define LOG_ERROR_EVERY_MS(ms, msg, ...) LOG_IF_ENABLED(ERROR, LOG_EVERY_MS(ERROR, ms, Logger::Logger::instance().error(LOGGER_FORMAT(msg), ##__VA_ARGS__)))
+    #define LOG_ERROR_RATE(per_second, burst, msg, ...) LOG_IF_ENABLED(ERROR, LOG_RATE(ERROR, per_second, burst, Logger::Logger::instance().error(LOGGER_FORMAT(msg), ##__VA_ARGS__)))
+#else
+    #define LOG_ERROR_EVERY_N(n, msg, ...)
+    #define LOG_ERROR_EVERY_MS(ms, msg, ...)
+    #define LOG_ERROR_RATE(per_second, burst, msg, ...)
+#endif
+
+#if LOGGER_MIN_LEVEL <= LOGGER_LEVEL_WARNING
+    #define LOG_WARNING_EVERY_N(n, msg, ...) LOG_IF_ENABLED(WARNING, LOG_EVERY_N(n, Logger::Logger::instance().warning(LOGGER_FORMAT(msg), ##__VA_ARGS__)))
+    #define LOG_WARNING_EVERY_MS(ms, msg, ...) LOG_IF_ENABLED(WARNING, LOG_EVERY_MS(WARNING, ms, Logger::Logger::instance().warning(LOGGER_FORMAT(msg), ##__VA_ARGS__)))
+    #define LOG_WARNING_RATE(per_second, burst, msg, ...) LOG_IF_ENABLED(WARNING, LOG_RATE(WARNING, per_second, burst, Logger::Logger::instance().warning(LOGGER_FORMAT(msg), ##__VA_ARGS__)))
+#else
+    #define LOG_WARNING_EVERY_N(n, msg, ...)
+    #define LOG_WARNING_EVERY_MS(ms, msg, ...)
+    #define LOG_WARNING_RATE(per_second, burst, msg, ...)
+#endif
+
+#if LOGGER_MIN_LEVEL <= LOGGER_LEVEL_INFO
+    #define LOG_INFO_EVERY_N(n, msg, ...) LOG_IF_ENABLED(INFO, LOG_EVERY_N(n, Logger::Logger::instance().info(LOGGER_FORMAT(msg), ##__VA_ARGS__)))
+    #define LOG_INFO_EVERY_MS(ms, msg, ...) LOG_IF_ENABLED(INFO, LOG_EVERY_MS(INFO, ms, Logger::Logger::instance().info(LOGGER_FORMAT(msg), ##__VA_ARGS__)))
+    #define LOG_INFO_RATE(per_second, burst, msg, ...) LOG_IF_ENABLED(INFO, LOG_RATE(INFO, per_second, burst, Logger::Logger::instance().info(LOGGER_FORMAT(msg), ##__VA_ARGS__)))
+#else
+    #define LOG_INFO_EVERY_N(n, msg, ...)
+    #define LOG_INFO_EVERY_MS(ms, msg, ...)
+    #define LOG_INFO_RATE(per_second, burst, msg, ...)
+#endif
+
+#if (defined(LOGGER_DEBUG) || defined(LOGGER_FLIGHT_RECORDER)) && LOGGER_MIN_LEVEL <= LOGGER_LEVEL_DEBUG
+    #define LOG_DEBUG_EVERY_N(n, msg, ...) LOG_IF_ENABLED(DEBUG, LOG_EVERY_N(n, Logger::Logger::instance().debug(LOGGER_FORMAT(msg), ##__VA_ARGS__)))
+    #define LOG_DEBUG_EVERY_MS(ms, msg, ...) LOG_IF_ENABLED(DEBUG, LOG_EVERY_MS(DEBUG, ms, Logger::Logger::instance().debug(LOGGER_FORMAT(msg), ##__VA_ARGS__)))
+    #define LOG_DEBUG_RATE(per_second, burst, msg, ...) LOG_IF_ENABLED(DEBUG, LOG_RATE(DEBUG, per_second, burst, Logger::Logger::instance().debug(LOGGER_FORMAT(msg), ##__VA_ARGS__)))
+#else
+    #define LOG_DEBUG_EVERY_N(n, msg, ...)
+    #define LOG_DEBUG_EVERY_MS(ms, msg, ...)
+    #define LOG_DEBUG_RATE(per_second, burst, msg, ...)
+#endif
+//--------------------------------------------------------------
+// **Structured logging: LOG_INFO_KV("request done", "latency_us", latency, "status", status)**
+// Text output appends " key=value" per field, JSON output adds one member per field.
+//--------------------------------------------------------------
+#define LOG_KV(level, msg, ...) do { \
+    if (LOGGER_UNLIKELY(!Logger::Logger::is_enabled(Logger::LogLevel::level))) break; \
+    static Logger::KeyValueSite UNIQUE_VAR(log_kv_site_); \
+    Logger::Logger::instance().log_kv(UNIQUE_VAR(log_kv_site_), Logger::LogLevel::level, msg, ##__VA_ARGS__); \
+} while(0)
+
+#if LOGGER_MIN_LEVEL <= LOGGER_LEVEL_ERROR
+    #define LOG_ERROR_KV(msg, ...) LOG_KV(ERROR, msg, ##__VA_ARGS__)
+#else
+    #define LOG_ERROR_KV(msg, ...)
+#endif
+
+#if LOGGER_MIN_LEVEL <= LOGGER_LEVEL_WARNING
+    #define LOG_WARNING_KV(msg, ...) LOG_KV(WARNING, msg, ##__VA_ARGS__)
+#else
+    #define LOG_WARNING_KV(msg, ...)
+#endif
+
+#if LOGGER_MIN_LEVEL <= LOGGER_LEVEL_INFO
+    #define LOG_INFO_KV(msg, ...) LOG_KV(INFO, msg, ##__VA_ARGS__)
+#else
+    #define LOG_INFO_KV(msg, ...)
+#endif
+
+#if (defined(LOGGER_DEBUG) || defined(LOGGER_FLIGHT_RECORDER)) && LOGGER_MIN_LEVEL <= LOGGER_LEVEL_DEBUG
+    #define LOG_DEBUG_KV(msg, ...) LOG_KV(DEBUG, msg, ##__VA_ARGS__)
+#else
+    #define LOG_DEBUG_KV(msg, ...)
+#endif
+//--------------------------------------------------------------
+// **Scope timing and trace marks: LOG_SCOPE_TIMER("db.query") times the rest of the enclosing block**
+// Names are string literals. LOG_TRACE_BEGIN and LOG_TRACE_END pair up on the same thread.
+//--------------------------------------------------------------
+#if LOGGER_MIN_LEVEL < LOGGER_LEVEL_OFF
+    #define LOG_SCOPE_TIMER(name) Logger::ScopeTimer UNIQUE_VAR(log_scope_timer_)(name)
+    #define LOG_TRACE_BEGIN(name) do { \
+        if (LOGGER_LIKELY(!Logger::Logger::is_tracing())) break; \
+        Logger::Logger::instance().trace_mark(name, Logger::TracePhase::BEGIN); \
+    } while(0)
+    #define LOG_TRACE_END(name) do { \
+        if (LOGGER_LIKELY(!Logger::Logger::is_tracing())) break; \
+        Logger::Logger::instance().trace_mark(name, Logger::TracePhase::END); \
+    } while(0)
+#else
+    #define LOG_SCOPE_TIMER(name)
+    #define LOG_TRACE_BEGIN(name)
+    #define LOG_TRACE_END(name)
+#endif
+//--------------------------------------------------------------
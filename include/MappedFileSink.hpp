@@ -0,0 +1,65 @@
+#pragma once
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <cstdint>
+#include <string>
+#include <string_view>
+//--------------------------------------------------------------
+// Logger library
+//--------------------------------------------------------------
+#include "Sink.hpp"
+#include "FileSink.hpp"
+//--------------------------------------------------------------
+namespace Logger {
+    //--------------------------------------------------------------
+    struct MappedFileSinkOptions {
+        size_t segment_size     = 64UL * 1024UL * 1024UL;
+        Durability durability   = Durability::FLUSH; // FDATASYNC msyncs the written range on every flush
+    }; // end struct MappedFileSinkOptions
+    //--------------------------------------------------------------
+    // **Writes lines into preallocated, memory-mapped segments named <filename>.000000, .000001, ...**
+    // A segment is truncated to its used length when it is closed. Segments left behind by a crash are
+    // cut back to their last complete line when the sink is next opened (POSIX only).
+    //--------------------------------------------------------------
+    class MappedFileSink : public Sink {
+        //--------------------------------------------------------------
+        public:
+            //--------------------------------------------------------------
+            // **Throws std::system_error when the first segment cannot be created**
+            explicit MappedFileSink(std::string filename, const MappedFileSinkOptions& options = MappedFileSinkOptions());
+            ~MappedFileSink(void) override;
+            //--------------------------
+            MappedFileSink(void)                                = delete;
+            MappedFileSink(const MappedFileSink&)               = delete;
+            MappedFileSink& operator=(const MappedFileSink&)    = delete;
+            MappedFileSink(MappedFileSink&&)                    = delete;
+            MappedFileSink& operator=(MappedFileSink&&)         = delete;
+            //--------------------------
+            void write(const LogRecord& record, std::string_view formatted) override;
+            //--------------------------
+            void flush(void) override;
+            //--------------------------
+            // **Truncates a segment after its last '\n', returns the resulting size or -1 on error**
+            static int64_t recover(const std::string& path);
+            //--------------------------
+            std::string segment_path(const uint32_t& index) const;
+            //--------------------------------------------------------------
+        private:
+            //--------------------------------------------------------------
+            bool open_segment(const size_t& size);
+            void close_segment(void);
+            //--------------------------------------------------------------
+            std::string m_filename;
+            MappedFileSinkOptions m_options;
+            uint32_t m_index;
+            int m_fd;
+            char* m_data;
+            size_t m_size;
+            size_t m_used;
+            size_t m_synced;
+        //--------------------------------------------------------------
+    }; // end class MappedFileSink
+    //--------------------------------------------------------------
+} // end namespace Logger
+//--------------------------------------------------------------
@@ -0,0 +1,91 @@
+#pragma once
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+//--------------------------------------------------------------
+// Logger library
+//--------------------------------------------------------------
+#include "LogLevel.hpp"
+//--------------------------------------------------------------
+namespace Logger {
+    //--------------------------------------------------------------
+    struct MetricsOptions {
+        bool enabled                                = true;
+        std::string prometheus_file;                // Rewritten every dump_interval when set, empty disables the dump
+        std::chrono::milliseconds dump_interval     = std::chrono::milliseconds(10000);
+    }; // end struct MetricsOptions
+    //--------------------------------------------------------------
+    // **Caller latency histogram: bucket i counts calls up to 64 ns << i, the last one everything slower**
+    //--------------------------------------------------------------
+    constexpr size_t LATENCY_BUCKETS = 24UL;
+    //--------------------------------------------------------------
+    constexpr uint64_t latency_bound(const size_t& bucket) {
+        return 64ULL << bucket;
+    } // end constexpr uint64_t latency_bound(const size_t& bucket)
+    //--------------------------------------------------------------
+    constexpr size_t latency_bucket(const uint64_t& nanoseconds) {
+        const size_t _width = static_cast<size_t>(std::bit_width(nanoseconds ? nanoseconds - 1ULL : 0ULL));
+        return _width <= 6UL ? 0UL : (_width - 6UL < LATENCY_BUCKETS ? _width - 6UL : LATENCY_BUCKETS - 1UL);
+    } // end constexpr size_t latency_bucket(const uint64_t& nanoseconds)
+    //--------------------------------------------------------------
+    struct MetricsSnapshot;
+    //--------------------------------------------------------------
+    // **Counters of one thread**
+    // Only the owning thread writes them, with a plain load and store instead of a locked
+    // read-modify-write; snapshots read them from any thread. Each shard sits on its own cache lines.
+    //--------------------------------------------------------------
+    struct alignas(64) MetricsShard {
+        std::array<std::atomic<uint64_t>, LEVEL_COUNT> messages{};
+        std::array<std::atomic<uint64_t>, LATENCY_BUCKETS> latency{};
+        std::atomic<uint64_t> latency_nanoseconds{0UL};
+        std::atomic<uint64_t> lock_waits{0UL};
+        std::atomic<uint64_t> lock_wait_nanoseconds{0UL};
+        std::atomic<bool> closed{false}; // Set when the owning thread exits
+        //--------------------------
+        static void add(std::atomic<uint64_t>& counter, const uint64_t& value) {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        } // end static void add(std::atomic<uint64_t>& counter, const uint64_t& value)
+        //--------------------------
+        // **Adds the shard's counters to the snapshot's**
+        void collect(MetricsSnapshot& snapshot) const;
+    }; // end struct MetricsShard
+    //--------------------------------------------------------------
+    struct SinkMetrics {
+        std::string name;               // SinkOptions::name, or console, error_log, warning_log, sinkN
+        uint64_t writes             = 0UL;
+        uint64_t write_nanoseconds  = 0UL;
+        uint64_t flushes            = 0UL;
+        uint64_t flush_nanoseconds  = 0UL;
+    }; // end struct SinkMetrics
+    //--------------------------------------------------------------
+    // **Logger::metrics(): totals since metrics were enabled, indexed with level_index()**
+    //--------------------------------------------------------------
+    struct MetricsSnapshot {
+        std::array<uint64_t, LEVEL_COUNT> messages{};           // Calls that reached the logger, dropped ones included
+        std::array<uint64_t, LEVEL_COUNT> bytes{};              // Message and field text written
+        std::array<uint64_t, LEVEL_COUNT> dropped{};            // Lost to backpressure, counted since start
+        std::array<uint64_t, LATENCY_BUCKETS> latency{};        // Calls per latency bucket, not cumulative
+        uint64_t latency_nanoseconds    = 0UL;                  // Time spent in LOG_* calls after the timestamp
+        uint64_t lock_waits             = 0UL;                  // Write lock acquisitions that had to wait
+        uint64_t lock_wait_nanoseconds  = 0UL;
+        uint64_t queue_high_water       = 0UL;                  // Most records the writer found in one ring in one pass
+        std::vector<SinkMetrics> sinks;
+        //--------------------------
+        uint64_t calls(void) const;
+        //--------------------------
+        // **Prometheus text exposition format, metric names start with logger_**
+        void write_prometheus(std::string& output) const;
+        //--------------------------
+        // **Written to filename.tmp and renamed over filename, so a scraper never reads half a file**
+        bool write_prometheus_file(const std::string& filename) const;
+    }; // end struct MetricsSnapshot
+    //--------------------------------------------------------------
+} // end namespace Logger
+//--------------------------------------------------------------
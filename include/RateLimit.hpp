@@ -0,0 +1,127 @@
+#pragma once
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+//--------------------------------------------------------------
+namespace Logger {
+    //--------------------------------------------------------------
+    // **Per-call-site limiters behind the LOG_*_EVERY_N, LOG_*_EVERY_MS and LOG_*_RATE macros**
+    // A suppressed call costs one relaxed atomic operation (plus a clock read for the timed ones).
+    //--------------------------------------------------------------
+    namespace detail {
+        inline int64_t steady_nanoseconds(void) {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        } // end inline int64_t steady_nanoseconds(void)
+    } // end namespace detail
+    //--------------------------------------------------------------
+    // **Lets the 1st, (n+1)th, (2n+1)th, ... call through**
+    //--------------------------------------------------------------
+    class EveryN {
+        //--------------------------------------------------------------
+        public:
+            //--------------------------------------------------------------
+            explicit EveryN(const uint64_t& n) : m_n(std::max<uint64_t>(n, 1UL)) {}
+            //--------------------------
+            EveryN(const EveryN&)               = delete;
+            EveryN& operator=(const EveryN&)    = delete;
+            //--------------------------
+            bool should_log(void) {
+                return !(m_count.fetch_add(1UL, std::memory_order_relaxed) % m_n);
+            } // end bool should_log(void)
+            //--------------------------------------------------------------
+        private:
+            //--------------------------------------------------------------
+            const uint64_t m_n;
+            std::atomic<uint64_t> m_count{0UL};
+        //--------------------------------------------------------------
+    }; // end class EveryN
+    //--------------------------------------------------------------
+    // **Lets at most one call through per interval, counting the rest**
+    //--------------------------------------------------------------
+    class EveryInterval {
+        //--------------------------------------------------------------
+        public:
+            //--------------------------------------------------------------
+            explicit EveryInterval(const std::chrono::nanoseconds& interval) : m_interval(interval.count()) {}
+            //--------------------------
+            EveryInterval(const EveryInterval&)             = delete;
+            EveryInterval& operator=(const EveryInterval&)  = delete;
+            //--------------------------
+            // **suppressed receives the number of calls dropped since the previous one that passed**
+            bool should_log(uint64_t& suppressed) {
+                //--------------------------
+                const int64_t _now  = detail::steady_nanoseconds();
+                int64_t _next       = m_next.load(std::memory_order_relaxed);
+                //--------------------------
+                if (_now < _next || !m_next.compare_exchange_strong(_next, _now + m_interval, std::memory_order_relaxed)) {
+                    m_suppressed.fetch_add(1UL, std::memory_order_relaxed);
+                    return false;
+                } // end if (_now < _next || ...)
+                //--------------------------
+                suppressed = m_suppressed.exchange(0UL, std::memory_order_relaxed);
+                return true;
+                //--------------------------
+            } // end bool should_log(uint64_t& suppressed)
+            //--------------------------------------------------------------
+        private:
+            //--------------------------------------------------------------
+            const int64_t m_interval;
+            std::atomic<int64_t> m_next{0};
+            std::atomic<uint64_t> m_suppressed{0UL};
+        //--------------------------------------------------------------
+    }; // end class EveryInterval
+    //--------------------------------------------------------------
+    // **Token bucket of burst tokens refilled at per_second, kept as a single theoretical
+    // arrival time (GCRA) so that taking a token is one compare-and-swap**
+    //--------------------------------------------------------------
+    class TokenBucket {
+        //--------------------------------------------------------------
+        public:
+            //--------------------------------------------------------------
+            TokenBucket(const double& per_second, const double& burst) :
+                m_interval(static_cast<int64_t>(1e9 / std::max(per_second, 1e-9))),
+                m_limit(static_cast<int64_t>(std::max(burst, 1.0) * static_cast<double>(m_interval))) {}
+            //--------------------------
+            TokenBucket(const TokenBucket&)             = delete;
+            TokenBucket& operator=(const TokenBucket&)  = delete;
+            //--------------------------
+            // **suppressed receives the number of calls dropped since the previous one that passed**
+            bool should_log(uint64_t& suppressed) {
+                //--------------------------
+                const int64_t _now  = detail::steady_nanoseconds();
+                int64_t _arrival    = m_arrival.load(std::memory_order_relaxed);
+                //--------------------------
+                while (true) {
+                    //--------------------------
+                    const int64_t _next = std::max(_arrival, _now) + m_interval;
+                    if (_next - _now > m_limit) {
+                        m_suppressed.fetch_add(1UL, std::memory_order_relaxed);
+                        return false;
+                    } // end if (_next - _now > m_limit)
+                    //--------------------------
+                    if (m_arrival.compare_exchange_weak(_arrival, _next, std::memory_order_relaxed)) {
+                        break;
+                    } // end if (m_arrival.compare_exchange_weak(_arrival, _next, std::memory_order_relaxed))
+                    //--------------------------
+                } // end while (true)
+                //--------------------------
+                suppressed = m_suppressed.exchange(0UL, std::memory_order_relaxed);
+                return true;
+                //--------------------------
+            } // end bool should_log(uint64_t& suppressed)
+            //--------------------------------------------------------------
+        private:
+            //--------------------------------------------------------------
+            const int64_t m_interval;
+            const int64_t m_limit;
+            std::atomic<int64_t> m_arrival{0};
+            std::atomic<uint64_t> m_suppressed{0UL};
+        //--------------------------------------------------------------
+    }; // end class TokenBucket
+    //--------------------------------------------------------------
+} // end namespace Logger
+//--------------------------------------------------------------
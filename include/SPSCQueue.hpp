@@ -0,0 +1,209 @@
+#pragma once
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+//--------------------------------------------------------------
+namespace Logger {
+    //--------------------------------------------------------------
+    // **Bounded lock-free single-producer single-consumer ring**
+    // Every cell carries a sequence number telling the producer and the
+    // consumer whether it is free or holds a published value, so neither
+    // side has to read the other's index. When full, the producer may take
+    // over the oldest value with evict(); the consumer claims a value with
+    // take() before reading it, and skips cells it has been lapped on.
+    //--------------------------------------------------------------
+    template<typename T>
+    class SPSCQueue {
+        //--------------------------------------------------------------
+        public:
+            //--------------------------------------------------------------
+            explicit SPSCQueue(const size_t& capacity) : m_mask(round_capacity(capacity) - 1UL),
+                                                         m_buffer(std::make_unique<Cell[]>(m_mask + 1UL)),
+                                                         m_head(0UL),
+                                                         m_tail(0UL) {
+                //--------------------------
+                for (size_t i = 0; i <= m_mask; ++i) {
+                    m_buffer[i].m_sequence.store(i, std::memory_order_relaxed);
+                } // end for (size_t i = 0; i <= m_mask; ++i)
+                //--------------------------
+            } // end SPSCQueue(const size_t& capacity)
+            //--------------------------
+            SPSCQueue(void)                         = delete;
+            ~SPSCQueue(void)                        = default;
+            //--------------------------
+            SPSCQueue(const SPSCQueue&)             = delete;
+            SPSCQueue& operator=(const SPSCQueue&)  = delete;
+            SPSCQueue(SPSCQueue&&)                  = delete;
+            SPSCQueue& operator=(SPSCQueue&&)       = delete;
+            //--------------------------
+            // **Producer side**
+            bool try_push(T&& value) {
+                //--------------------------
+                Cell& _cell = m_buffer[m_head & m_mask];
+                //--------------------------
+                if (_cell.m_sequence.load(std::memory_order_acquire) != m_head) {
+                    return false; // Full
+                } // end if (_cell.m_sequence.load(std::memory_order_acquire) != m_head)
+                //--------------------------
+                _cell.m_data = std::move(value);
+                _cell.m_sequence.store(m_head + 1UL, std::memory_order_release);
+                ++m_head;
+                //--------------------------
+                return true;
+                //--------------------------
+            } // end bool try_push(T&& value)
+            //--------------------------
+            // **Producer side, in place: the free cell to fill, or nullptr when full; publish() releases it**
+            T* claim(void) {
+                //--------------------------
+                Cell& _cell = m_buffer[m_head & m_mask];
+                //--------------------------
+                if (_cell.m_sequence.load(std::memory_order_acquire) != m_head) {
+                    return nullptr;
+                } // end if (_cell.m_sequence.load(std::memory_order_acquire) != m_head)
+                //--------------------------
+                return &_cell.m_data;
+                //--------------------------
+            } // end T* claim(void)
+            //--------------------------
+            void publish(void) {
+                m_buffer[m_head & m_mask].m_sequence.store(m_head + 1UL, std::memory_order_release);
+                ++m_head;
+            } // end void publish(void)
+            //--------------------------
+            // **Producer side, after claim() found the ring full: the cell of the oldest value if allowed(value)
+            // and the consumer is not reading it, otherwise nullptr; publish() releases it**
+            template<typename Predicate>
+            T* evict(Predicate&& allowed) {
+                //--------------------------
+                Cell& _cell = m_buffer[m_head & m_mask];
+                size_t _expected = m_head - m_mask; // Published one lap ago
+                //--------------------------
+                // Only the producer writes values, reading one the consumer may also be reading is safe
+                if (_cell.m_sequence.load(std::memory_order_acquire) != _expected || !allowed(std::as_const(_cell.m_data))) {
+                    return nullptr;
+                } // end if (_cell.m_sequence.load(std::memory_order_acquire) != _expected || ...)
+                //--------------------------
+                if (!_cell.m_sequence.compare_exchange_strong(_expected, EVICTING, std::memory_order_acquire, std::memory_order_relaxed)) {
+                    return nullptr;
+                } // end if (!_cell.m_sequence.compare_exchange_strong(...))
+                //--------------------------
+                return &_cell.m_data;
+                //--------------------------
+            } // end T* evict(Predicate&& allowed)
+            //--------------------------
+            // **Consumer side: the oldest published value, or nullptr; for peeking, take() before reading it**
+            T* front(void) {
+                //--------------------------
+                while (true) {
+                    //--------------------------
+                    Cell& _cell = m_buffer[m_tail & m_mask];
+                    const size_t _sequence = _cell.m_sequence.load(std::memory_order_acquire);
+                    //--------------------------
+                    if (_sequence == m_tail + 1UL) {
+                        return &_cell.m_data;
+                    } // end if (_sequence == m_tail + 1UL)
+                    //--------------------------
+                    if (!lapped(_sequence, m_tail)) {
+                        return nullptr;
+                    } // end if (!lapped(_sequence, m_tail))
+                    //--------------------------
+                    // The producer overwrote this value with a later one, which is read when we get there
+                    ++m_tail;
+                    //--------------------------
+                } // end while (true)
+                //--------------------------
+            } // end T* front(void)
+            //--------------------------
+            // **Consumer side: claims the value front() returned, or nullptr if the producer evicted it meanwhile**
+            T* take(void) {
+                //--------------------------
+                Cell& _cell = m_buffer[m_tail & m_mask];
+                size_t _expected = m_tail + 1UL;
+                //--------------------------
+                if (!_cell.m_sequence.compare_exchange_strong(_expected, CONSUMING, std::memory_order_acquire, std::memory_order_relaxed)) {
+                    return nullptr;
+                } // end if (!_cell.m_sequence.compare_exchange_strong(...))
+                //--------------------------
+                return &_cell.m_data;
+                //--------------------------
+            } // end T* take(void)
+            //--------------------------
+            // **Consumer side: releases the value returned by take()**
+            void pop(void) {
+                m_buffer[m_tail & m_mask].m_sequence.store(m_tail + m_mask + 1UL, std::memory_order_release);
+                ++m_tail;
+            } // end void pop(void)
+            //--------------------------
+            // **Any thread, best effort: the published values not consumed yet, oldest first**
+            // Used by the crash handler, which cannot wait for the consumer.
+            template<typename Visitor>
+            void visit(Visitor&& visitor) const {
+                //--------------------------
+                const size_t _tail = m_tail;
+                for (size_t _position = _tail; _position - _tail <= m_mask; ++_position) {
+                    //--------------------------
+                    const Cell& _cell = m_buffer[_position & m_mask];
+                    const size_t _sequence = _cell.m_sequence.load(std::memory_order_acquire);
+                    //--------------------------
+                    if (_sequence == _position + 1UL) {
+                        visitor(_cell.m_data);
+                    } else if (_sequence != CONSUMING && !lapped(_sequence, _position)) {
+                        break;
+                    } // end if (_sequence == _position + 1UL)
+                    //--------------------------
+                } // end for (size_t _position = _tail; _position - _tail <= m_mask; ++_position)
+                //--------------------------
+            } // end void visit(Visitor&& visitor) const
+            //--------------------------
+            bool empty(void) const {
+                const size_t _sequence = m_buffer[m_tail & m_mask].m_sequence.load(std::memory_order_acquire);
+                return _sequence != m_tail + 1UL && !lapped(_sequence, m_tail);
+            } // end bool empty(void) const
+            //--------------------------
+            size_t capacity(void) const {
+                return m_mask + 1UL;
+            } // end size_t capacity(void) const
+            //--------------------------------------------------------------
+        private:
+            //--------------------------------------------------------------
+            struct Cell {
+                std::atomic<size_t> m_sequence;
+                T m_data;
+            }; // end struct Cell
+            //--------------------------
+            static constexpr size_t CACHE_LINE_SIZE = 64UL;
+            //--------------------------
+            // Transient cell states outside the sequence numbers
+            static constexpr size_t CONSUMING   = SIZE_MAX;         // Claimed by take()
+            static constexpr size_t EVICTING    = SIZE_MAX - 1UL;   // Claimed by evict()
+            //--------------------------
+            // **Whether the producer has taken over the cell at position for one of its later laps**
+            // A slow consumer can be lapped several times on the same cell, it skips it once per lap.
+            bool lapped(const size_t& sequence, const size_t& position) const {
+                return sequence == EVICTING ||
+                       (sequence != CONSUMING && sequence > position + 1UL && ((sequence - position - 1UL) & m_mask) == 0UL);
+            } // end bool lapped(const size_t& sequence, const size_t& position) const
+            //--------------------------
+            static size_t round_capacity(const size_t& capacity) {
+                size_t _capacity = 2UL;
+                while (_capacity < capacity) {
+                    _capacity <<= 1UL;
+                } // end while (_capacity < capacity)
+                return _capacity;
+            } // end static size_t round_capacity(const size_t& capacity)
+            //--------------------------------------------------------------
+            const size_t m_mask;
+            std::unique_ptr<Cell[]> m_buffer;
+            alignas(CACHE_LINE_SIZE) size_t m_head;
+            alignas(CACHE_LINE_SIZE) size_t m_tail;
+        //--------------------------------------------------------------
+    }; // end class SPSCQueue
+    //--------------------------------------------------------------
+} // end namespace Logger
+//--------------------------------------------------------------
@@ -0,0 +1,68 @@
+#pragma once
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <cstddef>
+#include <string>
+//--------------------------------------------------------------
+namespace Logger {
+    //--------------------------------------------------------------
+    // **Thread-local string a LOG_* call formats into, reused by every call of the thread**
+    // A nested call (a formatter that logs) gets a string of its own, and a buffer that
+    // grew past RETAINED_CAPACITY for an oversized record is released again.
+    //--------------------------------------------------------------
+    class ScratchBuffer {
+        //--------------------------------------------------------------
+        public:
+            //--------------------------------------------------------------
+            static constexpr size_t INITIAL_CAPACITY    = 1024UL;
+            static constexpr size_t RETAINED_CAPACITY   = 16UL * 1024UL;
+            //--------------------------------------------------------------
+            ScratchBuffer(void) : m_slot(slot()), m_owner(!m_slot.busy) {
+                if (m_owner) {
+                    m_slot.busy = true;
+                    m_slot.text.clear();
+                } // end if (m_owner)
+            } // end ScratchBuffer(void)
+            //--------------------------
+            ~ScratchBuffer(void) {
+                if (m_owner) {
+                    release(m_slot.text);
+                    m_slot.busy = false;
+                } // end if (m_owner)
+            } // end ~ScratchBuffer(void)
+            //--------------------------
+            ScratchBuffer(const ScratchBuffer&)             = delete;
+            ScratchBuffer& operator=(const ScratchBuffer&)  = delete;
+            ScratchBuffer(ScratchBuffer&&)                  = delete;
+            ScratchBuffer& operator=(ScratchBuffer&&)       = delete;
+            //--------------------------
+            std::string& text(void) {
+                return m_owner ? m_slot.text : m_fallback;
+            } // end std::string& text(void)
+            //--------------------------
+            // **Drops the storage of a reused string that an oversized record made too large**
+            static void release(std::string& text) {
+                if (text.capacity() > RETAINED_CAPACITY) {
+                    std::string().swap(text);
+                    text.reserve(INITIAL_CAPACITY);
+                } // end if (text.capacity() > RETAINED_CAPACITY)
+            } // end static void release(std::string& text)
+            //--------------------------------------------------------------
+        private:
+            //--------------------------------------------------------------
+            struct Slot {
+                std::string text;
+                bool busy = false;
+            }; // end struct Slot
+            //--------------------------
+            static Slot& slot(void);
+            //--------------------------------------------------------------
+            Slot& m_slot;
+            const bool m_owner;
+            std::string m_fallback;
+        //--------------------------------------------------------------
+    }; // end class ScratchBuffer
+    //--------------------------------------------------------------
+} // end namespace Logger
+//--------------------------------------------------------------
@@ -0,0 +1,65 @@
+#pragma once
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+//--------------------------------------------------------------
+// Logger library
+//--------------------------------------------------------------
+#include "LogRecord.hpp"
+#include "LogLevel.hpp"
+#include "Formatter.hpp"
+#include "Trace.hpp"
+//--------------------------------------------------------------
+namespace Logger {
+    //--------------------------------------------------------------
+    // **Destination attached with Logger::add_sink**
+    // Called with the logger's write lock held, never concurrently. A sink that is slow to
+    // write or flush can be wrapped in an AsyncSink so it does not hold up the others.
+    //--------------------------------------------------------------
+    class Sink {
+        //--------------------------------------------------------------
+        public:
+            //--------------------------------------------------------------
+            virtual ~Sink(void) = default;
+            //--------------------------
+            // **formatted is the record rendered by the sink's formatter**
+            virtual void write(const LogRecord& record, std::string_view formatted) = 0;
+            //--------------------------
+            virtual void flush(void) = 0;
+            //--------------------------
+            virtual void poll(const std::chrono::steady_clock::time_point& now) {
+                static_cast<void>(now);
+            } // end virtual void poll(const std::chrono::steady_clock::time_point& now)
+            //--------------------------
+            // **Set by the logger: true while a writer thread polls the sink and flushes it after
+            // each pass, false in synchronous mode where buffered lines should be written at once**
+            virtual void set_batching(const bool& enabled) {
+                static_cast<void>(enabled);
+            } // end virtual void set_batching(const bool& enabled)
+            //--------------------------
+            // **Scope timings and trace marks, see Logger::set_tracing; sinks without a timeline ignore them**
+            virtual void write_trace(const TraceEvent& event) {
+                static_cast<void>(event);
+            } // end virtual void write_trace(const TraceEvent& event)
+            //--------------------------
+            // **Called by the crash handler: write out buffered data using async-signal-safe calls only,
+            // without locking or allocating**
+            virtual void write_pending(void) noexcept {}
+        //--------------------------------------------------------------
+    }; // end class Sink
+    //--------------------------------------------------------------
+    // **Routing of one registered sink**
+    //--------------------------------------------------------------
+    struct SinkOptions {
+        uint8_t levels                  = level_mask(LogLevel::DEBUG);  // LogLevel bits the sink receives, see level_mask()
+        std::shared_ptr<Formatter> formatter    = nullptr;              // Renders formatted, null for the standard text line
+        std::string name;                                               // Label in Logger::metrics(), sinkN when empty
+    }; // end struct SinkOptions
+    //--------------------------------------------------------------
+} // end namespace Logger
+//--------------------------------------------------------------
@@ -0,0 +1,81 @@
+#pragma once
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+//--------------------------------------------------------------
+namespace Logger {
+    //--------------------------------------------------------------
+    enum class TimestampPrecision : uint8_t {
+        SECONDS         = 0,
+        MILLISECONDS    = 3,
+        MICROSECONDS    = 6,
+        NANOSECONDS     = 9
+    }; // end enum class TimestampPrecision : uint8_t
+    //--------------------------------------------------------------
+    enum class ClockSource : uint8_t {
+        SYSTEM  = 0,
+        TSC     = 1
+    }; // end enum class ClockSource : uint8_t
+    //--------------------------------------------------------------
+    // **Time stamp counter converted to wall time**
+    // Calibrated against std::chrono::system_clock; calibrate() fails and now() stays on the
+    // system clock where the CPU does not report an invariant counter (CPUID 0x80000007 EDX
+    // bit 8). A later calibrate() may run while other threads call now().
+    //--------------------------------------------------------------
+    class TscClock {
+        //--------------------------------------------------------------
+        public:
+            //--------------------------------------------------------------
+            static bool calibrate(const std::chrono::milliseconds& duration = std::chrono::milliseconds(20));
+            //--------------------------
+            static bool is_calibrated(void);
+            //--------------------------
+            static uint64_t ticks(void);
+            //--------------------------
+            static std::chrono::system_clock::time_point now(void);
+            //--------------------------
+            static std::chrono::system_clock::time_point to_time_point(const uint64_t& ticks);
+            //--------------------------------------------------------------
+        private:
+            //--------------------------------------------------------------
+            // Published under a sequence count, odd while calibrate() rewrites the fields
+            static std::atomic<bool> s_calibrated;
+            static std::atomic<uint64_t> s_sequence;
+            static std::atomic<uint64_t> s_base_ticks;
+            static std::atomic<int64_t> s_base_nanoseconds;
+            static std::atomic<double> s_nanoseconds_per_tick;
+        //--------------------------------------------------------------
+    }; // end class TscClock
+    //--------------------------------------------------------------
+    // **Formats "YYYY-MM-DD HH:MM:SS[.fraction]" from a per-thread cache**
+    // The calendar part is rebuilt only when the second changes; the fraction
+    // digits are patched in for every call.
+    //--------------------------------------------------------------
+    class Timestamp {
+        //--------------------------------------------------------------
+        public:
+            //--------------------------------------------------------------
+            static constexpr size_t SECONDS_LENGTH  = 19UL;
+            static constexpr size_t MAX_LENGTH      = SECONDS_LENGTH + 10UL;
+            //--------------------------
+            static void set_precision(const TimestampPrecision& precision);
+            static TimestampPrecision precision(void);
+            //--------------------------
+            static size_t format(const std::chrono::system_clock::time_point& time, char* buffer);
+            static size_t format(const std::chrono::system_clock::time_point& time, char* buffer, const TimestampPrecision& precision);
+            //--------------------------
+            // **Writes the lowest `digits` decimal digits of value, zero padded**
+            static void write_digits(char* buffer, uint64_t value, const size_t& digits);
+            //--------------------------------------------------------------
+        private:
+            //--------------------------------------------------------------
+            static std::atomic<TimestampPrecision> s_precision;
+        //--------------------------------------------------------------
+    }; // end class Timestamp
+    //--------------------------------------------------------------
+} // end namespace Logger
+//--------------------------------------------------------------
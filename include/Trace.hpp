@@ -0,0 +1,35 @@
+#pragma once
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <chrono>
+#include <cstdint>
+//--------------------------------------------------------------
+namespace Logger {
+    //--------------------------------------------------------------
+    // **Trace-event phase, the letter used by the Chrome trace-event format**
+    //--------------------------------------------------------------
+    enum class TracePhase : uint8_t {
+        COMPLETE    = 'X', // LOG_SCOPE_TIMER: start and duration
+        BEGIN       = 'B', // LOG_TRACE_BEGIN
+        END         = 'E'  // LOG_TRACE_END
+    }; // end enum class TracePhase : uint8_t
+    //--------------------------------------------------------------
+    // **One timed scope or one begin/end mark of a thread**
+    //--------------------------------------------------------------
+    struct TraceEvent {
+        const char* name                        = nullptr; // A literal, only the pointer is kept
+        std::chrono::system_clock::time_point time;         // Start of the scope, or the mark; same clock as the records
+        std::chrono::nanoseconds duration{0};               // COMPLETE only
+        uint64_t thread                         = 0UL;
+        TracePhase phase                        = TracePhase::COMPLETE;
+    }; // end struct TraceEvent
+    //--------------------------------------------------------------
+    struct TraceOptions {
+        bool events                             = true;     // Buffer events for the sinks that write traces, e.g. ChromeTraceSink
+        size_t capacity                         = 4096UL;   // Events per thread; a full buffer is handed over by its own thread
+        std::chrono::microseconds slow_threshold{0};        // LOG_SCOPE_TIMER scopes at least this long are logged at WARNING, 0 disables
+    }; // end struct TraceOptions
+    //--------------------------------------------------------------
+} // end namespace Logger
+//--------------------------------------------------------------
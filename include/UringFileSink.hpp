@@ -0,0 +1,69 @@
+#pragma once
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+//--------------------------------------------------------------
+// Logger library
+//--------------------------------------------------------------
+#include "Sink.hpp"
+#include "FileSink.hpp"
+//--------------------------------------------------------------
+namespace Logger {
+    //--------------------------------------------------------------
+    struct UringFileSinkOptions {
+        FileSinkOptions file;       // buffer_size is the size of each buffer; rotation is only done by the fallback
+        size_t buffers = 4UL;       // Buffers registered with the kernel, at most this many writes in flight
+    }; // end struct UringFileSinkOptions
+    //--------------------------------------------------------------
+    // **Log file written through io_uring on Linux**
+    // Lines are collected in fixed buffers registered with the kernel. A full buffer, the flush
+    // interval or flush() submits it as one write at an explicit offset and moves on to the next
+    // buffer without waiting, so up to `buffers` writes are in flight. With Durability::FDATASYNC
+    // each submission is followed by an fdatasync ordered after it. flush() waits for everything.
+    //
+    // Without LOGGER_USE_IO_URING, outside Linux, when the kernel refuses io_uring, or when rotation
+    // is configured, the sink writes through a plain FileSink instead. The file must not be
+    // written by anyone else while the sink holds it.
+    //--------------------------------------------------------------
+    class UringFileSink : public Sink {
+        //--------------------------------------------------------------
+        public:
+            //--------------------------------------------------------------
+            explicit UringFileSink(std::string filename, const UringFileSinkOptions& options = UringFileSinkOptions());
+            ~UringFileSink(void) override;
+            //--------------------------
+            UringFileSink(void)                             = delete;
+            UringFileSink(const UringFileSink&)             = delete;
+            UringFileSink& operator=(const UringFileSink&)  = delete;
+            UringFileSink(UringFileSink&&)                  = delete;
+            UringFileSink& operator=(UringFileSink&&)       = delete;
+            //--------------------------
+            void write(const LogRecord& record, std::string_view formatted) override;
+            //--------------------------
+            void flush(void) override;
+            //--------------------------
+            void poll(const std::chrono::steady_clock::time_point& now) override;
+            //--------------------------
+            void set_batching(const bool& enabled) override;
+            //--------------------------
+            void write_pending(void) noexcept override;
+            //--------------------------
+            // **false when the lines go through the FileSink fallback**
+            bool is_uring(void) const;
+            //--------------------------------------------------------------
+        private:
+            //--------------------------------------------------------------
+            // Ring mappings and buffers, defined next to the system calls
+            class Ring;
+            //--------------------------
+            std::unique_ptr<Ring> m_ring;
+            std::unique_ptr<FileSink> m_fallback;
+        //--------------------------------------------------------------
+    }; // end class UringFileSink
+    //--------------------------------------------------------------
+} // end namespace Logger
+//--------------------------------------------------------------
@@ -0,0 +1,259 @@
+//--------------------------------------------------------------
+// Main Header
+//--------------------------------------------------------------
+#include "ArgumentCapture.hpp"
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <exception>
+#include <stdexcept>
+#include <iterator>
+//--------------------------------------------------------------
+#if __cpp_lib_format
+    #include <format>
+#else
+    #include <fmt/core.h>
+#endif
+//--------------------------------------------------------------
+namespace {
+    //--------------------------------------------------------------
+    constexpr size_t MAX_ARGUMENTS = Logger::CapturedArguments::CAPACITY / 2UL;
+    //--------------------------------------------------------------
+    struct DecodedArgument {
+        Logger::ArgumentType type;
+        union {
+            bool boolean;
+            char character;
+            int64_t signed_integer;
+            uint64_t unsigned_integer;
+            float single;
+            double real;
+            uintptr_t pointer;
+        };
+        std::string_view text;
+    }; // end struct DecodedArgument
+    //--------------------------------------------------------------
+    template<typename T>
+    T read(const std::byte*& cursor) {
+        T _value;
+        std::memcpy(&_value, cursor, sizeof(T));
+        cursor += sizeof(T);
+        return _value;
+    } // end T read(const std::byte*& cursor)
+    //--------------------------------------------------------------
+    size_t decode(const std::byte* data, const size_t& size, std::array<DecodedArgument, MAX_ARGUMENTS>& arguments) {
+        //--------------------------
+        const std::byte* _cursor    = data;
+        const std::byte* _end       = data + size;
+        size_t _count               = 0UL;
+        //--------------------------
+        while (_cursor < _end && _count < MAX_ARGUMENTS) {
+            DecodedArgument& _argument = arguments[_count++];
+            _argument.type = read<Logger::ArgumentType>(_cursor);
+            switch (_argument.type) {
+                case Logger::ArgumentType::BOOL:
+                    _argument.boolean = read<bool>(_cursor);
+                    break;
+                case Logger::ArgumentType::CHAR:
+                    _argument.character = read<char>(_cursor);
+                    break;
+                case Logger::ArgumentType::INT64:
+                    _argument.signed_integer = read<int64_t>(_cursor);
+                    break;
+                case Logger::ArgumentType::UINT64:
+                    _argument.unsigned_integer = read<uint64_t>(_cursor);
+                    break;
+                case Logger::ArgumentType::FLOAT:
+                    _argument.single = read<float>(_cursor);
+                    break;
+                case Logger::ArgumentType::DOUBLE:
+                    _argument.real = read<double>(_cursor);
+                    break;
+                case Logger::ArgumentType::POINTER:
+                    _argument.pointer = read<uintptr_t>(_cursor);
+                    break;
+                case Logger::ArgumentType::STRING: {
+                    const auto _length = read<uint32_t>(_cursor);
+                    _argument.text = std::string_view(reinterpret_cast<const char*>(_cursor), _length);
+                    _cursor += _length;
+                    break;
+                }
+                default:
+                    return _count - 1UL;
+            } // end switch (_argument.type)
+        } // end while (_cursor < _end && _count < MAX_ARGUMENTS)
+        //--------------------------
+        return _count;
+        //--------------------------
+    } // end size_t decode(const std::byte* data, const size_t& size, std::array<DecodedArgument, MAX_ARGUMENTS>& arguments)
+    //--------------------------------------------------------------
+    template<typename T>
+    void format_value(std::string& output, const std::string& pattern, const T& value) {
+#if __cpp_lib_format
+        std::vformat_to(std::back_inserter(output), pattern, std::make_format_args(value));
+#else
+        fmt::format_to(std::back_inserter(output), fmt::runtime(pattern), value);
+#endif
+    } // end void format_value(std::string& output, const std::string& pattern, const T& value)
+    //--------------------------------------------------------------
+    void format_argument(std::string& output, const DecodedArgument& argument, std::string_view specification) {
+        //--------------------------
+        std::string _pattern;
+        _pattern.reserve(specification.size() + 3UL);
+        _pattern.append("{:").append(specification).push_back('}');
+        //--------------------------
+        switch (argument.type) {
+            case Logger::ArgumentType::BOOL:
+                format_value(output, _pattern, argument.boolean);
+                break;
+            case Logger::ArgumentType::CHAR:
+                format_value(output, _pattern, argument.character);
+                break;
+            case Logger::ArgumentType::INT64:
+                format_value(output, _pattern, argument.signed_integer);
+                break;
+            case Logger::ArgumentType::UINT64:
+                format_value(output, _pattern, argument.unsigned_integer);
+                break;
+            case Logger::ArgumentType::FLOAT:
+                format_value(output, _pattern, argument.single);
+                break;
+            case Logger::ArgumentType::DOUBLE:
+                format_value(output, _pattern, argument.real);
+                break;
+            case Logger::ArgumentType::POINTER: {
+                const void* _pointer = reinterpret_cast<const void*>(argument.pointer);
+                format_value(output, _pattern, _pointer);
+                break;
+            }
+            case Logger::ArgumentType::STRING:
+                format_value(output, _pattern, argument.text);
+                break;
+        } // end switch (argument.type)
+        //--------------------------
+    } // end void format_argument(std::string& output, const DecodedArgument& argument, std::string_view specification)
+    //--------------------------------------------------------------
+    size_t argument_index(std::string_view id, size_t& next_index) {
+        //--------------------------
+        if (id.empty()) {
+            return next_index++;
+        } // end if (id.empty())
+        //--------------------------
+        size_t _index = 0UL;
+        for (const char& c : id) {
+            if (c < '0' || c > '9') {
+                throw std::invalid_argument("named arguments are not supported");
+            } // end if (c < '0' || c > '9')
+            _index = _index * 10UL + static_cast<size_t>(c - '0');
+        } // end for (const char& c : id)
+        //--------------------------
+        return _index;
+        //--------------------------
+    } // end size_t argument_index(std::string_view id, size_t& next_index)
+    //--------------------------------------------------------------
+    std::string integer_text(const DecodedArgument& argument) {
+        switch (argument.type) {
+            case Logger::ArgumentType::INT64:
+                return std::to_string(argument.signed_integer);
+            case Logger::ArgumentType::UINT64:
+                return std::to_string(argument.unsigned_integer);
+            default:
+                throw std::invalid_argument("width/precision is not an integer");
+        } // end switch (argument.type)
+    } // end std::string integer_text(const DecodedArgument& argument)
+    //--------------------------------------------------------------
+} // end namespace
+//--------------------------------------------------------------
+std::string Logger::render(std::string_view format, const CapturedArguments& arguments) {
+    //--------------------------
+    std::string _output;
+    render_to(_output, format, arguments.data.data(), arguments.size);
+    return _output;
+    //--------------------------
+} // end std::string Logger::render(std::string_view format, const CapturedArguments& arguments)
+//--------------------------------------------------------------
+void Logger::render_to(std::string& output, std::string_view format, const std::byte* data, const size_t& size) {
+    //--------------------------
+    std::array<DecodedArgument, MAX_ARGUMENTS> _arguments;
+    const size_t _count     = decode(data, size, _arguments);
+    size_t _next_index      = 0UL;
+    //--------------------------
+    const auto _lookup = [&](std::string_view id) -> const DecodedArgument& {
+        const size_t _index = argument_index(id, _next_index);
+        if (_index >= _count) {
+            throw std::out_of_range("argument not found");
+        } // end if (_index >= _count)
+        return _arguments[_index];
+    };
+    //--------------------------
+    try {
+        for (size_t i = 0; i < format.size(); ++i) {
+            //--------------------------
+            const char c = format[i];
+            //--------------------------
+            if (c == '}') {
+                if (i + 1UL >= format.size() || format[i + 1UL] != '}') {
+                    throw std::invalid_argument("unmatched '}' in format string");
+                } // end if (i + 1UL >= format.size() || format[i + 1UL] != '}')
+                output.push_back('}');
+                ++i;
+                continue;
+            } // end if (c == '}')
+            //--------------------------
+            if (c != '{') {
+                output.push_back(c);
+                continue;
+            } // end if (c != '{')
+            //--------------------------
+            if (i + 1UL < format.size() && format[i + 1UL] == '{') {
+                output.push_back('{');
+                ++i;
+                continue;
+            } // end if (i + 1UL < format.size() && format[i + 1UL] == '{')
+            //--------------------------
+            // Find the closing brace, allowing nested {} for dynamic width and precision
+            size_t _end     = i + 1UL;
+            size_t _depth   = 1UL;
+            for (; _end < format.size(); ++_end) {
+                if (format[_end] == '{') {
+                    ++_depth;
+                } else if (format[_end] == '}' && --_depth == 0UL) {
+                    break;
+                } // end if (format[_end] == '{')
+            } // end for (; _end < format.size(); ++_end)
+            //--------------------------
+            if (_end >= format.size()) {
+                throw std::invalid_argument("unmatched '{' in format string");
+            } // end if (_end >= format.size())
+            //--------------------------
+            const std::string_view _field   = format.substr(i + 1UL, _end - i - 1UL);
+            const size_t _colon             = _field.find(':');
+            const DecodedArgument& _value   = _lookup(_field.substr(0, _colon));
+            //--------------------------
+            std::string _specification;
+            if (_colon != std::string_view::npos) {
+                const std::string_view _raw = _field.substr(_colon + 1UL);
+                for (size_t j = 0; j < _raw.size(); ++j) {
+                    if (_raw[j] != '{') {
+                        _specification.push_back(_raw[j]);
+                        continue;
+                    } // end if (_raw[j] != '{')
+                    const size_t _close = _raw.find('}', j);
+                    if (_close == std::string_view::npos) {
+                        throw std::invalid_argument("unmatched '{' in format specification");
+                    } // end if (_close == std::string_view::npos)
+                    _specification += integer_text(_lookup(_raw.substr(j + 1UL, _close - j - 1UL)));
+                    j = _close;
+                } // end for (size_t j = 0; j < _raw.size(); ++j)
+            } // end if (_colon != std::string_view::npos)
+            //--------------------------
+            format_argument(output, _value, _specification);
+            i = _end;
+            //--------------------------
+        } // end for (size_t i = 0; i < format.size(); ++i)
+    } catch (const std::exception& e) {
+        output.append(" [format error: ").append(e.what()).push_back(']');
+    } // end try
+    //--------------------------
+} // end void Logger::render_to(std::string& output, std::string_view format, const std::byte* data, const size_t& size)
+//--------------------------------------------------------------
@@ -0,0 +1,167 @@
+//--------------------------------------------------------------
+// Main Header
+//--------------------------------------------------------------
+#include "AsyncSink.hpp"
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <algorithm>
+#include <utility>
+//--------------------------------------------------------------
+// Logger library
+//--------------------------------------------------------------
+#include "ScratchBuffer.hpp"
+//--------------------------------------------------------------
+Logger::AsyncSink::AsyncSink(std::shared_ptr<Sink> sink, const AsyncSinkOptions& options) : m_sink(std::move(sink)),
+                                                                                            m_options(options),
+                                                                                            m_entries(std::max<size_t>(options.capacity, 1UL)),
+                                                                                            m_head(0UL),
+                                                                                            m_tail(0UL),
+                                                                                            m_flush_requested(0UL),
+                                                                                            m_flush_completed(0UL),
+                                                                                            m_running(true),
+                                                                                            m_dropped(0UL) {
+    //--------------------------
+    // The worker polls the wrapped sink after every pass, whatever the logger's mode
+    m_sink->set_batching(true);
+    m_worker = std::thread(&AsyncSink::worker_loop, this);
+    //--------------------------
+} // end Logger::AsyncSink::AsyncSink(std::shared_ptr<Sink> sink, const AsyncSinkOptions& options)
+//--------------------------------------------------------------
+Logger::AsyncSink::~AsyncSink(void) {
+    //--------------------------
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+    }
+    m_work_cv.notify_one();
+    //--------------------------
+    // The worker writes what is queued and flushes before exiting
+    if (m_worker.joinable()) {
+        m_worker.join();
+    } // end if (m_worker.joinable())
+    //--------------------------
+} // end Logger::AsyncSink::~AsyncSink(void)
+//--------------------------------------------------------------
+void Logger::AsyncSink::write(const LogRecord& record, std::string_view formatted) {
+    //--------------------------
+    std::unique_lock<std::mutex> lock(m_mutex);
+    //--------------------------
+    Entry* _entry = claim(lock);
+    if (!_entry) {
+        return;
+    } // end if (!_entry)
+    //--------------------------
+    // Assignment keeps the capacity of the slot's strings
+    _entry->record = record;
+    _entry->formatted.assign(formatted);
+    _entry->is_trace = false;
+    ++m_tail;
+    //--------------------------
+    lock.unlock();
+    m_work_cv.notify_one();
+    //--------------------------
+} // end void Logger::AsyncSink::write(const LogRecord& record, std::string_view formatted)
+//--------------------------------------------------------------
+void Logger::AsyncSink::write_trace(const TraceEvent& event) {
+    //--------------------------
+    std::unique_lock<std::mutex> lock(m_mutex);
+    //--------------------------
+    Entry* _entry = claim(lock);
+    if (!_entry) {
+        return;
+    } // end if (!_entry)
+    //--------------------------
+    _entry->event    = event;
+    _entry->is_trace = true;
+    ++m_tail;
+    //--------------------------
+    lock.unlock();
+    m_work_cv.notify_one();
+    //--------------------------
+} // end void Logger::AsyncSink::write_trace(const TraceEvent& event)
+//--------------------------------------------------------------
+Logger::AsyncSink::Entry* Logger::AsyncSink::claim(std::unique_lock<std::mutex>& lock) {
+    //--------------------------
+    if (m_tail - m_head == m_entries.size()) {
+        //--------------------------
+        if (!m_options.block_when_full) {
+            m_dropped.fetch_add(1UL, std::memory_order_relaxed);
+            return nullptr;
+        } // end if (!m_options.block_when_full)
+        //--------------------------
+        m_done_cv.wait(lock, [this] { return m_tail - m_head < m_entries.size(); });
+        //--------------------------
+    } // end if (m_tail - m_head == m_entries.size())
+    //--------------------------
+    return &m_entries[m_tail % m_entries.size()];
+    //--------------------------
+} // end Logger::AsyncSink::Entry* Logger::AsyncSink::claim(std::unique_lock<std::mutex>& lock)
+//--------------------------------------------------------------
+void Logger::AsyncSink::flush(void) {
+    //--------------------------
+    std::unique_lock<std::mutex> lock(m_mutex);
+    //--------------------------
+    const uint64_t _ticket = ++m_flush_requested;
+    m_work_cv.notify_one();
+    m_done_cv.wait(lock, [this, _ticket] { return m_flush_completed >= _ticket; });
+    //--------------------------
+} // end void Logger::AsyncSink::flush(void)
+//--------------------------------------------------------------
+void Logger::AsyncSink::write_pending(void) noexcept {
+    m_sink->write_pending();
+} // end void Logger::AsyncSink::write_pending(void) noexcept
+//--------------------------------------------------------------
+uint64_t Logger::AsyncSink::dropped(void) const {
+    return m_dropped.load(std::memory_order_relaxed);
+} // end uint64_t Logger::AsyncSink::dropped(void) const
+//--------------------------------------------------------------
+void Logger::AsyncSink::worker_loop(void) {
+    //--------------------------
+    std::unique_lock<std::mutex> lock(m_mutex);
+    //--------------------------
+    while (true) {
+        //--------------------------
+        m_work_cv.wait_for(lock, m_options.poll_interval, [this] {
+            return m_head != m_tail || m_flush_requested != m_flush_completed || !m_running;
+        });
+        //--------------------------
+        const uint64_t _tail    = m_tail;
+        const uint64_t _flush   = m_flush_requested;
+        const bool _running     = m_running;
+        //--------------------------
+        // The wrapped sink runs unlocked, write() only touches slots outside [m_head, _tail)
+        lock.unlock();
+        //--------------------------
+        for (uint64_t i = m_head; i < _tail; ++i) {
+            Entry& _entry = m_entries[i % m_entries.size()];
+            if (_entry.is_trace) {
+                m_sink->write_trace(_entry.event);
+                continue;
+            } // end if (_entry.is_trace)
+            m_sink->write(_entry.record, _entry.formatted);
+            ScratchBuffer::release(_entry.record.message);
+            ScratchBuffer::release(_entry.record.fields);
+            ScratchBuffer::release(_entry.formatted);
+        } // end for (uint64_t i = m_head; i < _tail; ++i)
+        //--------------------------
+        if (_flush != m_flush_completed || !_running) {
+            m_sink->flush();
+        } else {
+            m_sink->poll(std::chrono::steady_clock::now());
+        } // end if (_flush != m_flush_completed || !_running)
+        //--------------------------
+        lock.lock();
+        //--------------------------
+        m_head              = _tail;
+        m_flush_completed   = _flush;
+        m_done_cv.notify_all();
+        //--------------------------
+        if (!_running && m_head == m_tail) {
+            break;
+        } // end if (!_running && m_head == m_tail)
+        //--------------------------
+    } // end while (true)
+    //--------------------------
+} // end void Logger::AsyncSink::worker_loop(void)
+//--------------------------------------------------------------
@@ -0,0 +1,374 @@
+//--------------------------------------------------------------
+// Main Header
+//--------------------------------------------------------------
+#include "BinarySink.hpp"
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+//--------------------------------------------------------------
+// Logger library
+//--------------------------------------------------------------
+#include "BinaryFormat.hpp"
+#include "KeyValue.hpp"
+//--------------------------------------------------------------
+namespace {
+    //--------------------------------------------------------------
+    constexpr std::string_view EAGER_FORMAT = "{}";
+    //--------------------------------------------------------------
+    Logger::FileSinkOptions binary_options(Logger::FileSinkOptions options) {
+        //--------------------------
+        options.header = false;
+        //--------------------------
+        // A rotated file would start without the session header and site dictionary
+        options.max_size            = 0UL;
+        options.rotation_interval   = std::chrono::seconds(0);
+        //--------------------------
+        return options;
+    } // end Logger::FileSinkOptions binary_options(Logger::FileSinkOptions options)
+    //--------------------------------------------------------------
+    int64_t nanoseconds(const std::chrono::system_clock::time_point& time) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    } // end int64_t nanoseconds(const std::chrono::system_clock::time_point& time)
+    //--------------------------------------------------------------
+    // **Re-encodes captured arguments compactly and collects their type signature**
+    //--------------------------------------------------------------
+    void encode_arguments(const Logger::CapturedArguments& arguments, std::string& types, std::string& output) {
+        //--------------------------
+        const std::byte* _cursor    = arguments.data.data();
+        const std::byte* _end       = _cursor + arguments.size;
+        //--------------------------
+        while (_cursor < _end) {
+            //--------------------------
+            Logger::ArgumentType _type;
+            std::memcpy(&_type, _cursor, sizeof(_type));
+            _cursor += sizeof(_type);
+            types.push_back(static_cast<char>(_type));
+            //--------------------------
+            switch (_type) {
+                case Logger::ArgumentType::BOOL:
+                case Logger::ArgumentType::CHAR:
+                    output.push_back(static_cast<char>(*_cursor));
+                    _cursor += 1;
+                    break;
+                case Logger::ArgumentType::INT64: {
+                    int64_t _value;
+                    std::memcpy(&_value, _cursor, sizeof(_value));
+                    _cursor += sizeof(_value);
+                    Logger::BinaryFormat::put_varint(output, Logger::BinaryFormat::zigzag(_value));
+                    break;
+                }
+                case Logger::ArgumentType::UINT64:
+                case Logger::ArgumentType::POINTER: {
+                    uint64_t _value;
+                    std::memcpy(&_value, _cursor, sizeof(_value));
+                    _cursor += sizeof(_value);
+                    Logger::BinaryFormat::put_varint(output, _value);
+                    break;
+                }
+                case Logger::ArgumentType::FLOAT:
+                    output.append(reinterpret_cast<const char*>(_cursor), sizeof(float));
+                    _cursor += sizeof(float);
+                    break;
+                case Logger::ArgumentType::DOUBLE:
+                    output.append(reinterpret_cast<const char*>(_cursor), sizeof(double));
+                    _cursor += sizeof(double);
+                    break;
+                case Logger::ArgumentType::STRING: {
+                    uint32_t _length;
+                    std::memcpy(&_length, _cursor, sizeof(_length));
+                    _cursor += sizeof(_length);
+                    Logger::BinaryFormat::put_bytes(output, std::string_view(reinterpret_cast<const char*>(_cursor), _length));
+                    _cursor += _length;
+                    break;
+                }
+            } // end switch (_type)
+            //--------------------------
+        } // end while (_cursor < _end)
+        //--------------------------
+    } // end void encode_arguments(const Logger::CapturedArguments& arguments, std::string& types, std::string& output)
+    //--------------------------------------------------------------
+    template<typename T>
+    void append_raw(std::string& output, const T& value) {
+        output.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    } // end void append_raw(std::string& output, const T& value)
+    //--------------------------------------------------------------
+} // end namespace
+//--------------------------------------------------------------
+Logger::BinarySink::BinarySink(std::string filename, const FileSinkOptions& options) :  m_file(std::move(filename), binary_options(options)),
+                                                                                        m_site_count(0U),
+                                                                                        m_last_time(0L),
+                                                                                        m_started(false) {
+    //--------------------------
+    // Opened up front so write_pending() has a descriptor even before the first commit
+    m_file.preopen();
+    //--------------------------
+} // end Logger::BinarySink::BinarySink(std::string filename, const FileSinkOptions& options)
+//--------------------------------------------------------------
+Logger::BinarySink::~BinarySink(void) {
+    m_file.flush();
+} // end Logger::BinarySink::~BinarySink(void)
+//--------------------------------------------------------------
+void Logger::BinarySink::write(const LogRecord& record, std::string_view formatted) {
+    //--------------------------
+    static_cast<void>(formatted);
+    //--------------------------
+    m_entry.clear();
+    //--------------------------
+    if (!m_started) {
+        m_entry.append(BinaryFormat::MAGIC);
+        m_entry.push_back(static_cast<char>(Timestamp::precision()));
+        m_started = true;
+    } // end if (!m_started)
+    //--------------------------
+    const SiteKey _key{record.format.empty() ? nullptr : record.format.data(), record.file, record.line, record.level};
+    std::string_view _format = EAGER_FORMAT;
+    m_types.clear();
+    m_arguments.clear();
+    //--------------------------
+    if (!record.format.empty()) {
+        _format = record.format;
+        encode_arguments(record.arguments, m_types, m_arguments);
+    } else if (record.site) {
+        // Structured fields are kept in their text form
+        m_message.assign(record.message);
+        record.site->append_text(m_message, record.fields);
+        m_types.push_back(static_cast<char>(ArgumentType::STRING));
+        BinaryFormat::put_bytes(m_arguments, m_message);
+    } else {
+        m_types.push_back(static_cast<char>(ArgumentType::STRING));
+        BinaryFormat::put_bytes(m_arguments, record.message);
+    } // end if (!record.format.empty())
+    //--------------------------
+    const uint32_t _id      = site(_key, _format);
+    const int64_t _time     = nanoseconds(record.time);
+    //--------------------------
+    m_entry.push_back(static_cast<char>(BinaryFormat::Entry::RECORD));
+    BinaryFormat::put_varint(m_entry, _id);
+    BinaryFormat::put_varint(m_entry, BinaryFormat::zigzag(_time - m_last_time));
+    m_entry.append(m_arguments);
+    m_last_time = _time;
+    //--------------------------
+    m_file.write_raw(m_entry);
+    //--------------------------
+} // end void Logger::BinarySink::write(const LogRecord& record, std::string_view formatted)
+//--------------------------------------------------------------
+void Logger::BinarySink::flush(void) {
+    m_file.flush();
+} // end void Logger::BinarySink::flush(void)
+//--------------------------------------------------------------
+void Logger::BinarySink::poll(const std::chrono::steady_clock::time_point& now) {
+    m_file.poll(now);
+} // end void Logger::BinarySink::poll(const std::chrono::steady_clock::time_point& now)
+//--------------------------------------------------------------
+void Logger::BinarySink::set_batching(const bool& enabled) {
+    m_file.set_batching(enabled);
+} // end void Logger::BinarySink::set_batching(const bool& enabled)
+//--------------------------------------------------------------
+void Logger::BinarySink::write_pending(void) noexcept {
+    m_file.write_pending(std::string_view());
+} // end void Logger::BinarySink::write_pending(void) noexcept
+//--------------------------------------------------------------
+size_t Logger::BinarySink::SiteKeyHash::operator()(const SiteKey& key) const {
+    //--------------------------
+    size_t _hash = std::hash<const void*>()(key.format);
+    _hash ^= std::hash<const void*>()(key.file) + 0x9e3779b97f4a7c15ULL + (_hash << 6U) + (_hash >> 2U);
+    _hash ^= std::hash<uint64_t>()((static_cast<uint64_t>(key.line) << 8U) | static_cast<uint64_t>(key.level)) + 0x9e3779b97f4a7c15ULL + (_hash << 6U) + (_hash >> 2U);
+    //--------------------------
+    return _hash;
+    //--------------------------
+} // end size_t Logger::BinarySink::SiteKeyHash::operator()(const SiteKey& key) const
+//--------------------------------------------------------------
+uint32_t Logger::BinarySink::site(const SiteKey& key, std::string_view format) {
+    //--------------------------
+    std::vector<Signature>& _signatures = m_sites[key];
+    for (const Signature& _signature : _signatures) {
+        if (_signature.types == m_types) {
+            return _signature.id;
+        } // end if (_signature.types == m_types)
+    } // end for (const Signature& _signature : _signatures)
+    //--------------------------
+    const uint32_t _id = m_site_count++;
+    _signatures.push_back(Signature{m_types, _id});
+    //--------------------------
+    m_entry.push_back(static_cast<char>(BinaryFormat::Entry::SITE));
+    BinaryFormat::put_varint(m_entry, _id);
+    m_entry.push_back(static_cast<char>(key.level));
+    BinaryFormat::put_bytes(m_entry, format);
+    BinaryFormat::put_bytes(m_entry, key.file ? std::string_view(key.file) : std::string_view());
+    BinaryFormat::put_varint(m_entry, key.line);
+    BinaryFormat::put_varint(m_entry, m_types.size());
+    m_entry.append(m_types);
+    //--------------------------
+    return _id;
+    //--------------------------
+} // end uint32_t Logger::BinarySink::site(const SiteKey& key, std::string_view format)
+//--------------------------------------------------------------
+Logger::BinaryDecoder::BinaryDecoder(std::istream& input) : m_input(input),
+                                                            m_last_time(0L),
+                                                            m_precision(TimestampPrecision::SECONDS) {
+    //--------------------------
+} // end Logger::BinaryDecoder::BinaryDecoder(std::istream& input)
+//--------------------------------------------------------------
+bool Logger::BinaryDecoder::next(std::string& line) {
+    //--------------------------
+    while (true) {
+        //--------------------------
+        const int _tag = m_input.peek();
+        if (_tag == std::char_traits<char>::eof()) {
+            return false;
+        } // end if (_tag == std::char_traits<char>::eof())
+        //--------------------------
+        if (_tag == BinaryFormat::MAGIC.front()) {
+            read_session();
+            continue;
+        } // end if (_tag == BinaryFormat::MAGIC.front())
+        //--------------------------
+        const auto _entry = static_cast<BinaryFormat::Entry>(read_byte());
+        //--------------------------
+        if (_entry == BinaryFormat::Entry::SITE) {
+            //--------------------------
+            const uint64_t _id = read_varint();
+            Site _site;
+            _site.level     = static_cast<LogLevel>(read_byte());
+            _site.format    = read_bytes();
+            read_bytes(); // file
+            read_varint(); // line
+            const uint64_t _count = read_varint();
+            for (uint64_t i = 0; i < _count; ++i) {
+                _site.types.push_back(static_cast<ArgumentType>(read_byte()));
+            } // end for (uint64_t i = 0; i < _count; ++i)
+            //--------------------------
+            if (_id != m_sites.size()) {
+                throw std::runtime_error("binary log: unexpected site id");
+            } // end if (_id != m_sites.size())
+            m_sites.push_back(std::move(_site));
+            continue;
+            //--------------------------
+        } // end if (_entry == BinaryFormat::Entry::SITE)
+        //--------------------------
+        if (_entry != BinaryFormat::Entry::RECORD) {
+            throw std::runtime_error("binary log: unknown entry");
+        } // end if (_entry != BinaryFormat::Entry::RECORD)
+        //--------------------------
+        const uint64_t _id = read_varint();
+        if (_id >= m_sites.size()) {
+            throw std::runtime_error("binary log: record refers to an unknown site");
+        } // end if (_id >= m_sites.size())
+        const Site& _site = m_sites[_id];
+        //--------------------------
+        m_last_time += BinaryFormat::unzigzag(read_varint());
+        //--------------------------
+        // Rebuild the in-memory capture layout so the writer's renderer can be reused
+        m_arguments.clear();
+        for (const auto& _type : _site.types) {
+            m_arguments.push_back(static_cast<char>(_type));
+            switch (_type) {
+                case ArgumentType::BOOL:
+                case ArgumentType::CHAR:
+                    m_arguments.push_back(static_cast<char>(read_byte()));
+                    break;
+                case ArgumentType::INT64:
+                    append_raw(m_arguments, BinaryFormat::unzigzag(read_varint()));
+                    break;
+                case ArgumentType::UINT64:
+                case ArgumentType::POINTER:
+                    append_raw(m_arguments, read_varint());
+                    break;
+                case ArgumentType::FLOAT: {
+                    float _value;
+                    read_raw(&_value, sizeof(_value));
+                    append_raw(m_arguments, _value);
+                    break;
+                }
+                case ArgumentType::DOUBLE: {
+                    double _value;
+                    read_raw(&_value, sizeof(_value));
+                    append_raw(m_arguments, _value);
+                    break;
+                }
+                case ArgumentType::STRING: {
+                    const std::string _text = read_bytes();
+                    append_raw(m_arguments, static_cast<uint32_t>(_text.size()));
+                    m_arguments.append(_text);
+                    break;
+                }
+                default:
+                    throw std::runtime_error("binary log: unknown argument type");
+            } // end switch (_type)
+        } // end for (const auto& _type : _site.types)
+        //--------------------------
+        char _timestamp[Timestamp::MAX_LENGTH];
+        const std::chrono::system_clock::time_point _time(std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(m_last_time)));
+        const size_t _length = Timestamp::format(_time, _timestamp, m_precision);
+        //--------------------------
+        line.assign(_timestamp, _length).append(level_tag(_site.level));
+        render_to(line, _site.format, reinterpret_cast<const std::byte*>(m_arguments.data()), m_arguments.size());
+        //--------------------------
+        return true;
+        //--------------------------
+    } // end while (true)
+    //--------------------------
+} // end bool Logger::BinaryDecoder::next(std::string& line)
+//--------------------------------------------------------------
+uint8_t Logger::BinaryDecoder::read_byte(void) {
+    //--------------------------
+    const int _value = m_input.get();
+    if (_value == std::char_traits<char>::eof()) {
+        throw std::runtime_error("binary log: truncated entry");
+    } // end if (_value == std::char_traits<char>::eof())
+    //--------------------------
+    return static_cast<uint8_t>(_value);
+    //--------------------------
+} // end uint8_t Logger::BinaryDecoder::read_byte(void)
+//--------------------------------------------------------------
+uint64_t Logger::BinaryDecoder::read_varint(void) {
+    //--------------------------
+    uint64_t _value = 0UL;
+    for (uint32_t _shift = 0U; _shift < 64U; _shift += 7U) {
+        const uint8_t _byte = read_byte();
+        _value |= static_cast<uint64_t>(_byte & 0x7FU) << _shift;
+        if (!(_byte & 0x80U)) {
+            return _value;
+        } // end if (!(_byte & 0x80U))
+    } // end for (uint32_t _shift = 0U; _shift < 64U; _shift += 7U)
+    //--------------------------
+    throw std::runtime_error("binary log: malformed varint");
+    //--------------------------
+} // end uint64_t Logger::BinaryDecoder::read_varint(void)
+//--------------------------------------------------------------
+std::string Logger::BinaryDecoder::read_bytes(void) {
+    //--------------------------
+    std::string _bytes(read_varint(), '\0');
+    read_raw(_bytes.data(), _bytes.size());
+    //--------------------------
+    return _bytes;
+    //--------------------------
+} // end std::string Logger::BinaryDecoder::read_bytes(void)
+//--------------------------------------------------------------
+void Logger::BinaryDecoder::read_raw(void* destination, const size_t& size) {
+    //--------------------------
+    if (!m_input.read(static_cast<char*>(destination), static_cast<std::streamsize>(size))) {
+        throw std::runtime_error("binary log: truncated entry");
+    } // end if (!m_input.read(static_cast<char*>(destination), static_cast<std::streamsize>(size)))
+    //--------------------------
+} // end void Logger::BinaryDecoder::read_raw(void* destination, const size_t& size)
+//--------------------------------------------------------------
+void Logger::BinaryDecoder::read_session(void) {
+    //--------------------------
+    char _magic[BinaryFormat::MAGIC.size()];
+    read_raw(_magic, sizeof(_magic));
+    //--------------------------
+    if (std::string_view(_magic, sizeof(_magic)) != BinaryFormat::MAGIC) {
+        throw std::runtime_error("binary log: bad magic");
+    } // end if (std::string_view(_magic, sizeof(_magic)) != BinaryFormat::MAGIC)
+    //--------------------------
+    m_precision = static_cast<TimestampPrecision>(read_byte());
+    m_sites.clear();
+    m_last_time = 0L;
+    //--------------------------
+} // end void Logger::BinaryDecoder::read_session(void)
+//--------------------------------------------------------------
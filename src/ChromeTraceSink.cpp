@@ -0,0 +1,143 @@
+//--------------------------------------------------------------
+// Main Header
+//--------------------------------------------------------------
+#include "ChromeTraceSink.hpp"
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <charconv>
+#include <utility>
+//--------------------------------------------------------------
+#if defined(_WIN32)
+    #include <process.h>
+#else
+    #include <unistd.h>
+#endif
+//--------------------------------------------------------------
+// Logger library
+//--------------------------------------------------------------
+#include "KeyValue.hpp"
+//--------------------------------------------------------------
+namespace {
+    //--------------------------------------------------------------
+    Logger::FileSinkOptions trace_options(Logger::FileSinkOptions options) {
+        options.header              = false; // The file has to parse
+        options.max_size            = 0UL;
+        options.rotation_interval   = std::chrono::seconds(0);
+        return options;
+    } // end Logger::FileSinkOptions trace_options(Logger::FileSinkOptions options)
+    //--------------------------------------------------------------
+    uint64_t process_id(void) {
+#if defined(_WIN32)
+        return static_cast<uint64_t>(_getpid());
+#else
+        return static_cast<uint64_t>(getpid());
+#endif
+    } // end uint64_t process_id(void)
+    //--------------------------------------------------------------
+    void append_number(std::string& output, const uint64_t& value) {
+        char _digits[24];
+        const auto _result = std::to_chars(_digits, _digits + sizeof(_digits), value);
+        output.append(_digits, _result.ptr);
+    } // end void append_number(std::string& output, const uint64_t& value)
+    //--------------------------------------------------------------
+} // end namespace
+//--------------------------------------------------------------
+Logger::ChromeTraceSink::ChromeTraceSink(std::string filename, const FileSinkOptions& options) :    m_file(std::move(filename), trace_options(options)),
+                                                                                                    m_first(true),
+                                                                                                    m_epoch(std::chrono::system_clock::now()),
+                                                                                                    m_pid(process_id()) {
+    //--------------------------
+    // Opened up front so write_pending() has a descriptor even before the first commit
+    m_file.preopen();
+    //--------------------------
+} // end Logger::ChromeTraceSink::ChromeTraceSink(std::string filename, const FileSinkOptions& options)
+//--------------------------------------------------------------
+Logger::ChromeTraceSink::~ChromeTraceSink(void) {
+    //--------------------------
+    m_file.write_raw(m_first ? "[]\n" : "]\n");
+    m_file.flush();
+    //--------------------------
+} // end Logger::ChromeTraceSink::~ChromeTraceSink(void)
+//--------------------------------------------------------------
+void Logger::ChromeTraceSink::write(const LogRecord& record, std::string_view formatted) {
+    //--------------------------
+    static_cast<void>(formatted);
+    //--------------------------
+    open_event(record.message, "log", 'i', record.time);
+    m_line.append(",\"s\":\"t\"");
+    append_ids(record.thread);
+    m_line.append(",\"args\":{\"level\":\"").append(level_name(record.level)).append("\"}}");
+    //--------------------------
+    m_file.write(m_line);
+    //--------------------------
+} // end void Logger::ChromeTraceSink::write(const LogRecord& record, std::string_view formatted)
+//--------------------------------------------------------------
+void Logger::ChromeTraceSink::write_trace(const TraceEvent& event) {
+    //--------------------------
+    open_event(event.name ? std::string_view(event.name) : std::string_view(), "scope", static_cast<char>(event.phase), event.time);
+    if (event.phase == TracePhase::COMPLETE) {
+        m_line.append(",\"dur\":");
+        append_microseconds(event.duration.count());
+    } // end if (event.phase == TracePhase::COMPLETE)
+    append_ids(event.thread);
+    m_line.push_back('}');
+    //--------------------------
+    m_file.write(m_line);
+    //--------------------------
+} // end void Logger::ChromeTraceSink::write_trace(const TraceEvent& event)
+//--------------------------------------------------------------
+void Logger::ChromeTraceSink::flush(void) {
+    m_file.flush();
+} // end void Logger::ChromeTraceSink::flush(void)
+//--------------------------------------------------------------
+void Logger::ChromeTraceSink::poll(const std::chrono::steady_clock::time_point& now) {
+    m_file.poll(now);
+} // end void Logger::ChromeTraceSink::poll(const std::chrono::steady_clock::time_point& now)
+//--------------------------------------------------------------
+void Logger::ChromeTraceSink::set_batching(const bool& enabled) {
+    m_file.set_batching(enabled);
+} // end void Logger::ChromeTraceSink::set_batching(const bool& enabled)
+//--------------------------------------------------------------
+void Logger::ChromeTraceSink::write_pending(void) noexcept {
+    m_file.write_pending(std::string_view());
+} // end void Logger::ChromeTraceSink::write_pending(void) noexcept
+//--------------------------------------------------------------
+void Logger::ChromeTraceSink::open_event(std::string_view name, std::string_view category, const char& phase,
+                                         const std::chrono::system_clock::time_point& time) {
+    //--------------------------
+    m_line.assign(m_first ? "[{\"name\":\"" : ",{\"name\":\"");
+    m_first = false;
+    Json::escape(m_line, name);
+    m_line.append("\",\"cat\":\"").append(category).append("\",\"ph\":\"");
+    m_line.push_back(phase);
+    m_line.append("\",\"ts\":");
+    append_microseconds(std::chrono::duration_cast<std::chrono::nanoseconds>(time - m_epoch).count());
+    //--------------------------
+} // end void Logger::ChromeTraceSink::open_event(...)
+//--------------------------------------------------------------
+void Logger::ChromeTraceSink::append_ids(const uint64_t& thread) {
+    //--------------------------
+    m_line.append(",\"pid\":");
+    append_number(m_line, m_pid);
+    m_line.append(",\"tid\":");
+    append_number(m_line, thread);
+    //--------------------------
+} // end void Logger::ChromeTraceSink::append_ids(const uint64_t& thread)
+//--------------------------------------------------------------
+void Logger::ChromeTraceSink::append_microseconds(const int64_t& nanoseconds) {
+    //--------------------------
+    // Fixed three decimals, events recorded before the sink existed come out negative
+    if (nanoseconds < 0) {
+        m_line.push_back('-');
+    } // end if (nanoseconds < 0)
+    const uint64_t _magnitude = nanoseconds < 0 ? 0ULL - static_cast<uint64_t>(nanoseconds) : static_cast<uint64_t>(nanoseconds);
+    //--------------------------
+    append_number(m_line, _magnitude / 1000ULL);
+    const uint64_t _fraction = _magnitude % 1000ULL;
+    const char _digits[4] = {'.', static_cast<char>('0' + _fraction / 100ULL), static_cast<char>('0' + _fraction / 10ULL % 10ULL),
+                             static_cast<char>('0' + _fraction % 10ULL)};
+    m_line.append(_digits, sizeof(_digits));
+    //--------------------------
+} // end void Logger::ChromeTraceSink::append_microseconds(const int64_t& nanoseconds)
+//--------------------------------------------------------------
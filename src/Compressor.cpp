@@ -0,0 +1,343 @@
+//--------------------------------------------------------------
+// Main Header
+//--------------------------------------------------------------
+#include "Compressor.hpp"
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdio>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <vector>
+//--------------------------------------------------------------
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <sys/resource.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+//--------------------------------------------------------------
+#if defined(LOGGER_HAS_ZLIB)
+    #include <zlib.h>
+#endif
+#if defined(LOGGER_HAS_ZSTD)
+    #include <zstd.h>
+#endif
+//--------------------------------------------------------------
+namespace {
+    //--------------------------------------------------------------
+    constexpr size_t CHUNK_SIZE = 64UL * 1024UL;
+    //--------------------------------------------------------------
+    constexpr std::string_view extension(const Logger::Compression& compression) {
+        switch (compression) {
+            case Logger::Compression::GZIP: return ".gz";
+            case Logger::Compression::ZSTD: return ".zst";
+            default:                        return "";
+        } // end switch (compression)
+    } // end constexpr std::string_view extension(const Logger::Compression& compression)
+    //--------------------------------------------------------------
+    // **Generation number of <prefix><digits>[.gz|.zst], if name is one**
+    //--------------------------------------------------------------
+    std::optional<uint32_t> parse_generation(std::string_view name, std::string_view prefix) {
+        //--------------------------
+        if (!name.starts_with(prefix)) {
+            return std::nullopt;
+        } // end if (!name.starts_with(prefix))
+        name.remove_prefix(prefix.size());
+        //--------------------------
+        uint32_t _generation = 0;
+        const auto _result = std::from_chars(name.data(), name.data() + name.size(), _generation);
+        if (_result.ec != std::errc() || _result.ptr == name.data()) {
+            return std::nullopt;
+        } // end if (_result.ec != std::errc() || _result.ptr == name.data())
+        //--------------------------
+        const std::string_view _suffix(_result.ptr, static_cast<size_t>(name.data() + name.size() - _result.ptr));
+        if (!_suffix.empty() && _suffix != ".gz" && _suffix != ".zst") {
+            return std::nullopt;
+        } // end if (!_suffix.empty() && _suffix != ".gz" && _suffix != ".zst")
+        //--------------------------
+        return _generation;
+        //--------------------------
+    } // end std::optional<uint32_t> parse_generation(std::string_view name, std::string_view prefix)
+    //--------------------------------------------------------------
+    // **Calls visit(path, generation) for every generation of filename on disk**
+    //--------------------------------------------------------------
+    template<typename Visit>
+    void for_each_generation(const std::string& filename, Visit&& visit) {
+        //--------------------------
+        const std::filesystem::path _path(filename);
+        const std::filesystem::path _directory = _path.has_parent_path() ? _path.parent_path() : std::filesystem::path(".");
+        const std::string _prefix = _path.filename().string() + '.';
+        //--------------------------
+        std::error_code _error;
+        for (const auto& _entry : std::filesystem::directory_iterator(_directory, _error)) {
+            if (const auto _generation = parse_generation(_entry.path().filename().string(), _prefix)) {
+                visit(_entry.path(), *_generation);
+            } // end if (const auto _generation = parse_generation(...))
+        } // end for (const auto& _entry : std::filesystem::directory_iterator(_directory, _error))
+        //--------------------------
+    } // end void for_each_generation(const std::string& filename, Visit&& visit)
+    //--------------------------------------------------------------
+    void lower_priority(void) {
+#if defined(_WIN32)
+        SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+#elif defined(__linux__)
+        // On Linux the nice value is per thread
+        static_cast<void>(setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 19));
+#elif defined(__APPLE__)
+        static_cast<void>(setpriority(PRIO_DARWIN_THREAD, 0, PRIO_DARWIN_BG));
+#endif
+    } // end void lower_priority(void)
+    //--------------------------------------------------------------
+#if defined(LOGGER_HAS_ZLIB)
+    bool compress_gzip(std::FILE* input, const std::string& output) {
+        //--------------------------
+        gzFile _output = gzopen(output.c_str(), "wb6");
+        if (!_output) {
+            return false;
+        } // end if (!_output)
+        //--------------------------
+        std::array<char, CHUNK_SIZE> _chunk;
+        bool _ok = true;
+        size_t _read;
+        //--------------------------
+        while (_ok && (_read = std::fread(_chunk.data(), 1, _chunk.size(), input)) > 0) {
+            _ok = gzwrite(_output, _chunk.data(), static_cast<unsigned>(_read)) == static_cast<int>(_read);
+        } // end while (_ok && ...)
+        //--------------------------
+        return (gzclose(_output) == Z_OK) && _ok && !std::ferror(input);
+        //--------------------------
+    } // end bool compress_gzip(std::FILE* input, const std::string& output)
+#endif
+    //--------------------------------------------------------------
+#if defined(LOGGER_HAS_ZSTD)
+    bool compress_zstd(std::FILE* input, const std::string& output) {
+        //--------------------------
+        std::FILE* _output = std::fopen(output.c_str(), "wb");
+        if (!_output) {
+            return false;
+        } // end if (!_output)
+        //--------------------------
+        ZSTD_CCtx* _context = ZSTD_createCCtx();
+        ZSTD_CCtx_setParameter(_context, ZSTD_c_compressionLevel, 3);
+        //--------------------------
+        std::vector<char> _in(ZSTD_CStreamInSize());
+        std::vector<char> _out(ZSTD_CStreamOutSize());
+        bool _ok = _context != nullptr;
+        bool _last = false;
+        //--------------------------
+        while (_ok && !_last) {
+            //--------------------------
+            const size_t _read = std::fread(_in.data(), 1, _in.size(), input);
+            _last = _read < _in.size();
+            //--------------------------
+            ZSTD_inBuffer _input = {_in.data(), _read, 0};
+            bool _finished = false;
+            //--------------------------
+            while (_ok && !_finished) {
+                ZSTD_outBuffer _output_buffer = {_out.data(), _out.size(), 0};
+                const size_t _remaining = ZSTD_compressStream2(_context, &_output_buffer, &_input, _last ? ZSTD_e_end : ZSTD_e_continue);
+                _ok = !ZSTD_isError(_remaining) &&
+                      std::fwrite(_out.data(), 1, _output_buffer.pos, _output) == _output_buffer.pos;
+                _finished = _last ? _remaining == 0 : _input.pos == _input.size;
+            } // end while (_ok && !_finished)
+            //--------------------------
+        } // end while (_ok && !_last)
+        //--------------------------
+        ZSTD_freeCCtx(_context);
+        //--------------------------
+        return (std::fclose(_output) == 0) && _ok && !std::ferror(input);
+        //--------------------------
+    } // end bool compress_zstd(std::FILE* input, const std::string& output)
+#endif
+    //--------------------------------------------------------------
+} // end namespace
+//--------------------------------------------------------------
+std::shared_ptr<Logger::Compressor> Logger::Compressor::shared(void) {
+    //--------------------------
+    static std::mutex s_mutex;
+    static std::weak_ptr<Compressor> s_compressor;
+    //--------------------------
+    std::lock_guard<std::mutex> lock(s_mutex);
+    //--------------------------
+    std::shared_ptr<Compressor> _compressor = s_compressor.lock();
+    if (!_compressor) {
+        _compressor     = std::make_shared<Compressor>();
+        s_compressor    = _compressor;
+    } // end if (!_compressor)
+    //--------------------------
+    return _compressor;
+    //--------------------------
+} // end std::shared_ptr<Logger::Compressor> Logger::Compressor::shared(void)
+//--------------------------------------------------------------
+Logger::Compressor::Compressor(void) : m_busy(false), m_stop(false) {
+    m_thread = std::thread(&Compressor::run, this);
+} // end Logger::Compressor::Compressor(void)
+//--------------------------------------------------------------
+Logger::Compressor::~Compressor(void) {
+    //--------------------------
+    // Finish what is queued so no rotated file is left uncompressed
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_one();
+    //--------------------------
+    if (m_thread.joinable()) {
+        m_thread.join();
+    } // end if (m_thread.joinable())
+    //--------------------------
+} // end Logger::Compressor::~Compressor(void)
+//--------------------------------------------------------------
+void Logger::Compressor::submit(const std::string& filename, const uint32_t& generation, const size_t& max_files, const Compression& compression) {
+    //--------------------------
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back(Job{filename, generation, max_files, compression});
+    }
+    m_cv.notify_one();
+    //--------------------------
+} // end void Logger::Compressor::submit(...)
+//--------------------------------------------------------------
+void Logger::Compressor::wait(void) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle_cv.wait(lock, [this] { return m_jobs.empty() && !m_busy; });
+} // end void Logger::Compressor::wait(void)
+//--------------------------------------------------------------
+Logger::Compression Logger::Compressor::resolve(const Compression& compression) {
+    //--------------------------
+    if (compression == Compression::NONE) {
+        return Compression::NONE;
+    } // end if (compression == Compression::NONE)
+    //--------------------------
+#if defined(LOGGER_HAS_ZSTD)
+    if (compression != Compression::GZIP) {
+        return Compression::ZSTD;
+    } // end if (compression != Compression::GZIP)
+#endif
+#if defined(LOGGER_HAS_ZLIB)
+    return Compression::GZIP;
+#elif defined(LOGGER_HAS_ZSTD)
+    return Compression::ZSTD;
+#else
+    return Compression::NONE;
+#endif
+    //--------------------------
+} // end Logger::Compression Logger::Compressor::resolve(const Compression& compression)
+//--------------------------------------------------------------
+std::string Logger::Compressor::generation_path(const std::string& filename, const uint32_t& generation) {
+    return filename + '.' + std::to_string(generation);
+} // end std::string Logger::Compressor::generation_path(const std::string& filename, const uint32_t& generation)
+//--------------------------------------------------------------
+uint32_t Logger::Compressor::last_generation(const std::string& filename) {
+    //--------------------------
+    uint32_t _last = 0U;
+    for_each_generation(filename, [&_last](const std::filesystem::path&, const uint32_t& generation) {
+        _last = std::max(_last, generation);
+    });
+    //--------------------------
+    return _last;
+    //--------------------------
+} // end uint32_t Logger::Compressor::last_generation(const std::string& filename)
+//--------------------------------------------------------------
+void Logger::Compressor::run(void) {
+    //--------------------------
+    lower_priority();
+    //--------------------------
+    std::unique_lock<std::mutex> lock(m_mutex);
+    //--------------------------
+    while (true) {
+        //--------------------------
+        m_cv.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+        //--------------------------
+        if (m_jobs.empty()) {
+            break; // Stopping with nothing left to do
+        } // end if (m_jobs.empty())
+        //--------------------------
+        const Job _job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+        m_busy = true;
+        //--------------------------
+        lock.unlock();
+        compress(generation_path(_job.filename, _job.generation), resolve(_job.compression));
+        prune(_job.filename, _job.generation, _job.max_files);
+        lock.lock();
+        //--------------------------
+        m_busy = false;
+        if (m_jobs.empty()) {
+            m_idle_cv.notify_all();
+        } // end if (m_jobs.empty())
+        //--------------------------
+    } // end while (true)
+    //--------------------------
+} // end void Logger::Compressor::run(void)
+//--------------------------------------------------------------
+void Logger::Compressor::compress(const std::string& path, const Compression& compression) {
+    //--------------------------
+    if (compression == Compression::NONE) {
+        return;
+    } // end if (compression == Compression::NONE)
+    //--------------------------
+    std::FILE* _input = std::fopen(path.c_str(), "rb");
+    if (!_input) {
+        return;
+    } // end if (!_input)
+    //--------------------------
+    // Written under a temporary name so a partial archive never looks like a generation
+    const std::string _output   = path + std::string(extension(compression));
+    const std::string _temporary = _output + ".tmp";
+    bool _ok = false;
+    //--------------------------
+    switch (compression) {
+#if defined(LOGGER_HAS_ZLIB)
+        case Compression::GZIP:
+            _ok = compress_gzip(_input, _temporary);
+            break;
+#endif
+#if defined(LOGGER_HAS_ZSTD)
+        case Compression::ZSTD:
+            _ok = compress_zstd(_input, _temporary);
+            break;
+#endif
+        default:
+            break;
+    } // end switch (compression)
+    //--------------------------
+    std::fclose(_input);
+    //--------------------------
+    std::error_code _error;
+    if (_ok) {
+        std::filesystem::rename(_temporary, _output, _error);
+        _ok = !_error;
+    } // end if (_ok)
+    //--------------------------
+    std::filesystem::remove(_ok ? path : _temporary, _error);
+    //--------------------------
+} // end void Logger::Compressor::compress(const std::string& path, const Compression& compression)
+//--------------------------------------------------------------
+void Logger::Compressor::prune(const std::string& filename, const uint32_t& newest, const size_t& max_files) {
+    //--------------------------
+    if (!max_files) {
+        return; // Keep everything
+    } // end if (!max_files)
+    //--------------------------
+    std::vector<std::filesystem::path> _expired;
+    for_each_generation(filename, [&](const std::filesystem::path& path, const uint32_t& generation) {
+        if (static_cast<uint64_t>(generation) + max_files <= newest) {
+            _expired.push_back(path);
+        } // end if (static_cast<uint64_t>(generation) + max_files <= newest)
+    });
+    //--------------------------
+    std::error_code _error;
+    for (const auto& _path : _expired) {
+        std::filesystem::remove(_path, _error);
+    } // end for (const auto& _path : _expired)
+    //--------------------------
+} // end void Logger::Compressor::prune(const std::string& filename, const uint32_t& newest, const size_t& max_files)
+//--------------------------------------------------------------
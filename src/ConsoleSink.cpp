@@ -0,0 +1,168 @@
+//--------------------------------------------------------------
+// Main Header
+//--------------------------------------------------------------
+#include "ConsoleSink.hpp"
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <cerrno>
+//--------------------------------------------------------------
+#if defined(_WIN32)
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+//--------------------------------------------------------------
+// Definitions
+//--------------------------------------------------------------
+#define ANSI_COLOR_RED              "\x1b[31m"
+#define ANSI_COLOR_YELLOW           "\x1b[33m"
+#define ANSI_COLOR_RESET            "\x1b[0m"
+//--------------------------------------------------------------
+Logger::ConsoleSink::ConsoleSink(const ConsoleSinkOptions& options) :   m_options(options),
+                                                                        m_out{stdout, fileno(stdout), false, false, {}},
+                                                                        m_err{stderr, fileno(stderr), false, false, {}},
+                                                                        m_last_commit(std::chrono::steady_clock::now()),
+                                                                        m_batching(false) {
+    //--------------------------
+    configure(m_out);
+    configure(m_err);
+    //--------------------------
+} // end Logger::ConsoleSink::ConsoleSink(const ConsoleSinkOptions& options)
+//--------------------------------------------------------------
+Logger::ConsoleSink::~ConsoleSink(void) {
+    flush();
+} // end Logger::ConsoleSink::~ConsoleSink(void)
+//--------------------------------------------------------------
+void Logger::ConsoleSink::write(const LogRecord& record, std::string_view formatted) {
+    write(record.level, formatted);
+} // end void Logger::ConsoleSink::write(const LogRecord& record, std::string_view formatted)
+//--------------------------------------------------------------
+void Logger::ConsoleSink::write(const LogLevel& level, std::string_view formatted) {
+    //--------------------------
+    Stream& _stream = (level == LogLevel::ERROR && m_options.errors_to_stderr) ? m_err : m_out;
+    //--------------------------
+    const char* _color = nullptr;
+    if (_stream.color) {
+        if (level == LogLevel::ERROR) {
+            _color = ANSI_COLOR_RED;
+        } else if (level == LogLevel::WARNING) {
+            _color = ANSI_COLOR_YELLOW;
+        } // end if (level == LogLevel::ERROR)
+    } // end if (_stream.color)
+    //--------------------------
+    if (_color) {
+        _stream.buffer.append(_color).append(formatted).append(ANSI_COLOR_RESET);
+    } else {
+        _stream.buffer.append(formatted);
+    } // end if (_color)
+    _stream.buffer.push_back('\n');
+    //--------------------------
+    // Without a writer thread nothing polls the sink, so the line is written now
+    if (_stream.buffer.size() >= m_options.buffer_size || !m_batching) {
+        commit(_stream);
+    } else {
+        poll(std::chrono::steady_clock::now());
+    } // end if (_stream.buffer.size() >= m_options.buffer_size || ...)
+    //--------------------------
+} // end void Logger::ConsoleSink::write(const LogLevel& level, std::string_view formatted)
+//--------------------------------------------------------------
+void Logger::ConsoleSink::flush(void) {
+    //--------------------------
+    commit(m_out);
+    commit(m_err);
+    m_last_commit = std::chrono::steady_clock::now();
+    //--------------------------
+} // end void Logger::ConsoleSink::flush(void)
+//--------------------------------------------------------------
+void Logger::ConsoleSink::poll(const std::chrono::steady_clock::time_point& now) {
+    //--------------------------
+    if (now - m_last_commit >= m_options.flush_interval) {
+        flush();
+    } // end if (now - m_last_commit >= m_options.flush_interval)
+    //--------------------------
+} // end void Logger::ConsoleSink::poll(const std::chrono::steady_clock::time_point& now)
+//--------------------------------------------------------------
+void Logger::ConsoleSink::write_pending(void) noexcept {
+    //--------------------------
+    // No fflush here, stdio is not async-signal-safe
+    for (Stream* _stream : {&m_out, &m_err}) {
+        write_all(_stream->descriptor, _stream->buffer);
+        _stream->buffer.clear();
+    } // end for (Stream* _stream : {&m_out, &m_err})
+    //--------------------------
+} // end void Logger::ConsoleSink::write_pending(void) noexcept
+//--------------------------------------------------------------
+int Logger::ConsoleSink::descriptor(const LogLevel& level) const {
+    return (level == LogLevel::ERROR && m_options.errors_to_stderr) ? m_err.descriptor : m_out.descriptor;
+} // end int Logger::ConsoleSink::descriptor(const LogLevel& level) const
+//--------------------------------------------------------------
+void Logger::ConsoleSink::set_options(const ConsoleSinkOptions& options) {
+    //--------------------------
+    flush();
+    m_options = options;
+    configure(m_out);
+    configure(m_err);
+    //--------------------------
+} // end void Logger::ConsoleSink::set_options(const ConsoleSinkOptions& options)
+//--------------------------------------------------------------
+void Logger::ConsoleSink::set_batching(const bool& enabled) {
+    //--------------------------
+    flush();
+    m_batching = enabled;
+    //--------------------------
+} // end void Logger::ConsoleSink::set_batching(const bool& enabled)
+//--------------------------------------------------------------
+void Logger::ConsoleSink::configure(Stream& stream) {
+    //--------------------------
+    // A terminal cannot turn into a pipe, so it is checked once
+#if defined(_WIN32)
+    stream.terminal = _isatty(stream.descriptor) != 0;
+#else
+    stream.terminal = isatty(stream.descriptor) != 0;
+#endif
+    //--------------------------
+    stream.color = m_options.color == ColorMode::ALWAYS || (m_options.color == ColorMode::AUTO && stream.terminal);
+    //--------------------------
+    if (&stream == &m_out || m_options.errors_to_stderr) {
+        stream.buffer.reserve(m_options.buffer_size);
+    } // end if (&stream == &m_out || m_options.errors_to_stderr)
+    //--------------------------
+} // end void Logger::ConsoleSink::configure(Stream& stream)
+//--------------------------------------------------------------
+void Logger::ConsoleSink::commit(Stream& stream) {
+    //--------------------------
+    if (stream.buffer.empty()) {
+        return;
+    } // end if (stream.buffer.empty())
+    //--------------------------
+    // Whatever the application printed through stdio comes first
+    std::fflush(stream.file);
+    //--------------------------
+    write_all(stream.descriptor, stream.buffer);
+    //--------------------------
+    stream.buffer.clear();
+    //--------------------------
+} // end void Logger::ConsoleSink::commit(Stream& stream)
+//--------------------------------------------------------------
+bool Logger::ConsoleSink::write_all(const int& descriptor, std::string_view data) noexcept {
+    //--------------------------
+    while (!data.empty()) {
+#if defined(_WIN32)
+        const int _written = _write(descriptor, data.data(), static_cast<unsigned int>(data.size()));
+#else
+        const ssize_t _written = ::write(descriptor, data.data(), data.size());
+#endif
+        if (_written < 0 && errno == EINTR) {
+            continue;
+        } // end if (_written < 0 && errno == EINTR)
+        if (_written <= 0) {
+            return false; // Nothing sensible to do when the console is gone
+        } // end if (_written <= 0)
+        data.remove_prefix(static_cast<size_t>(_written));
+    } // end while (!data.empty())
+    //--------------------------
+    return true;
+    //--------------------------
+} // end bool Logger::ConsoleSink::write_all(const int& descriptor, std::string_view data) noexcept
+//--------------------------------------------------------------
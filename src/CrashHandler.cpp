@@ -0,0 +1,331 @@
+//--------------------------------------------------------------
+// Main Header
+//--------------------------------------------------------------
+#include "CrashHandler.hpp"
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <ctime>
+#include <exception>
+#include <iterator>
+//--------------------------------------------------------------
+#include <signal.h>
+#include <unistd.h>
+//--------------------------------------------------------------
+// Logger library
+//--------------------------------------------------------------
+#include "Logger.hpp"
+//--------------------------------------------------------------
+namespace {
+    //--------------------------------------------------------------
+    constexpr int FATAL_SIGNALS[] = {SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL};
+    constexpr size_t SIGNAL_COUNT = std::size(FATAL_SIGNALS);
+    //--------------------------------------------------------------
+    std::atomic<bool> s_installed{false};
+    std::atomic<bool> s_crashing{false};
+    struct sigaction s_previous[SIGNAL_COUNT];
+    std::terminate_handler s_previous_terminate = nullptr;
+    long s_utc_offset = 0L; // Seconds, taken at install time
+    //--------------------------
+    // Lets a stack overflow still reach the handler on the installing thread
+    alignas(16) char s_alternate_stack[64UL * 1024UL];
+    //--------------------------------------------------------------
+    // **Fixed-size line assembled without allocating, longer text is cut**
+    //--------------------------------------------------------------
+    struct Line {
+        char data[4096];
+        size_t size = 0UL;
+        //--------------------------
+        void append(std::string_view text) {
+            const size_t _count = std::min(text.size(), sizeof(data) - 1UL - size);
+            std::memcpy(data + size, text.data(), _count);
+            size += _count;
+        } // end void append(std::string_view text)
+        //--------------------------
+        void append_number(uint64_t value) {
+            char _digits[20];
+            size_t _length = 0UL;
+            do {
+                _digits[sizeof(_digits) - ++_length] = static_cast<char>('0' + value % 10UL);
+                value /= 10UL;
+            } while (value);
+            append(std::string_view(_digits + sizeof(_digits) - _length, _length));
+        } // end void append_number(uint64_t value)
+        //--------------------------
+        void append_digits(uint64_t value, const size_t& digits) {
+            for (size_t i = digits; i > 0 && size + i <= sizeof(data) - 1UL; --i) {
+                data[size + i - 1UL] = static_cast<char>('0' + value % 10UL);
+                value /= 10UL;
+            } // end for (size_t i = digits; i > 0 && ...; --i)
+            size = std::min(size + digits, sizeof(data) - 1UL);
+        } // end void append_digits(uint64_t value, const size_t& digits)
+        //--------------------------
+        // **Same layout as Timestamp::format, from the UTC offset captured by install()**
+        void append_time(const std::chrono::system_clock::time_point& time) {
+            //--------------------------
+            const int64_t _nanoseconds  = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+            int64_t _second             = _nanoseconds / 1'000'000'000L + s_utc_offset;
+            int64_t _fraction           = _nanoseconds % 1'000'000'000L;
+            if (_fraction < 0) {
+                _fraction += 1'000'000'000L;
+                --_second;
+            } // end if (_fraction < 0)
+            //--------------------------
+            // Civil date from days since 1970-01-01, localtime_r is not async-signal-safe
+            int64_t _days               = (_second >= 0 ? _second : _second - 86399L) / 86400L;
+            const int64_t _of_day       = _second - _days * 86400L;
+            _days                      += 719468L;
+            const int64_t _era          = (_days >= 0 ? _days : _days - 146096L) / 146097L;
+            const int64_t _day_of_era   = _days - _era * 146097L;
+            const int64_t _year_of_era  = (_day_of_era - _day_of_era / 1460L + _day_of_era / 36524L - _day_of_era / 146096L) / 365L;
+            const int64_t _day_of_year  = _day_of_era - (365L * _year_of_era + _year_of_era / 4L - _year_of_era / 100L);
+            const int64_t _month_index  = (5L * _day_of_year + 2L) / 153L;
+            const int64_t _day          = _day_of_year - (153L * _month_index + 2L) / 5L + 1L;
+            const int64_t _month        = _month_index < 10L ? _month_index + 3L : _month_index - 9L;
+            const int64_t _year         = _year_of_era + _era * 400L + (_month <= 2L ? 1L : 0L);
+            //--------------------------
+            append_digits(static_cast<uint64_t>(_year), 4UL);
+            append("-");
+            append_digits(static_cast<uint64_t>(_month), 2UL);
+            append("-");
+            append_digits(static_cast<uint64_t>(_day), 2UL);
+            append(" ");
+            append_digits(static_cast<uint64_t>(_of_day / 3600L), 2UL);
+            append(":");
+            append_digits(static_cast<uint64_t>(_of_day / 60L % 60L), 2UL);
+            append(":");
+            append_digits(static_cast<uint64_t>(_of_day % 60L), 2UL);
+            //--------------------------
+            const auto _digits = static_cast<size_t>(Logger::Timestamp::precision());
+            if (_digits) {
+                uint64_t _value = static_cast<uint64_t>(_fraction);
+                for (size_t i = _digits; i < 9UL; ++i) {
+                    _value /= 10UL;
+                } // end for (size_t i = _digits; i < 9UL; ++i)
+                append(".");
+                append_digits(_value, _digits);
+            } // end if (_digits)
+            //--------------------------
+        } // end void append_time(const std::chrono::system_clock::time_point& time)
+        //--------------------------
+        std::string_view view(void) const {
+            return std::string_view(data, size);
+        } // end std::string_view view(void) const
+    }; // end struct Line
+    //--------------------------------------------------------------
+    void write_all(const int& descriptor, std::string_view data) {
+        //--------------------------
+        while (descriptor >= 0 && !data.empty()) {
+            const ssize_t _written = ::write(descriptor, data.data(), data.size());
+            if (_written < 0 && errno == EINTR) {
+                continue;
+            } // end if (_written < 0 && errno == EINTR)
+            if (_written <= 0) {
+                return;
+            } // end if (_written <= 0)
+            data.remove_prefix(static_cast<size_t>(_written));
+        } // end while (descriptor >= 0 && !data.empty())
+        //--------------------------
+    } // end void write_all(const int& descriptor, std::string_view data)
+    //--------------------------------------------------------------
+    std::string_view signal_name(const int& signal) {
+        switch (signal) {
+            case SIGSEGV:   return "SIGSEGV";
+            case SIGABRT:   return "SIGABRT";
+            case SIGBUS:    return "SIGBUS";
+            case SIGFPE:    return "SIGFPE";
+            case SIGILL:    return "SIGILL";
+            default:        return "unknown";
+        } // end switch (signal)
+    } // end std::string_view signal_name(const int& signal)
+    //--------------------------------------------------------------
+} // end namespace
+//--------------------------------------------------------------
+void Logger::CrashHandler::install(void) {
+    //--------------------------
+    if (s_installed.exchange(true)) {
+        return;
+    } // end if (s_installed.exchange(true))
+    //--------------------------
+    // Everything the handler touches has to exist before the crash
+    Logger& _logger = Logger::instance();
+    {
+        std::lock_guard<std::mutex> lock(_logger.m_mutex);
+        _logger.m_error_file->preopen();
+        _logger.m_warning_file->preopen();
+    }
+    //--------------------------
+    const std::time_t _now = std::time(nullptr);
+    std::tm _local{};
+    localtime_r(&_now, &_local);
+    s_utc_offset = _local.tm_gmtoff;
+    //--------------------------
+    stack_t _stack{};
+    _stack.ss_sp    = s_alternate_stack;
+    _stack.ss_size  = sizeof(s_alternate_stack);
+    sigaltstack(&_stack, nullptr);
+    //--------------------------
+    struct sigaction _action{};
+    _action.sa_handler  = &CrashHandler::handle_signal;
+    _action.sa_flags    = SA_ONSTACK;
+    sigemptyset(&_action.sa_mask);
+    //--------------------------
+    for (size_t i = 0; i < SIGNAL_COUNT; ++i) {
+        sigaction(FATAL_SIGNALS[i], &_action, &s_previous[i]);
+    } // end for (size_t i = 0; i < SIGNAL_COUNT; ++i)
+    //--------------------------
+    s_previous_terminate = std::set_terminate(&CrashHandler::handle_terminate);
+    //--------------------------
+} // end void Logger::CrashHandler::install(void)
+//--------------------------------------------------------------
+void Logger::CrashHandler::uninstall(void) {
+    //--------------------------
+    if (!s_installed.exchange(false)) {
+        return;
+    } // end if (!s_installed.exchange(false))
+    //--------------------------
+    for (size_t i = 0; i < SIGNAL_COUNT; ++i) {
+        sigaction(FATAL_SIGNALS[i], &s_previous[i], nullptr);
+    } // end for (size_t i = 0; i < SIGNAL_COUNT; ++i)
+    //--------------------------
+    std::set_terminate(s_previous_terminate);
+    //--------------------------
+} // end void Logger::CrashHandler::uninstall(void)
+//--------------------------------------------------------------
+bool Logger::CrashHandler::is_installed(void) {
+    return s_installed.load(std::memory_order_acquire);
+} // end bool Logger::CrashHandler::is_installed(void)
+//--------------------------------------------------------------
+void Logger::CrashHandler::handle_signal(int signal) {
+    //--------------------------
+    const int _errno = errno;
+    //--------------------------
+    // Only the first crashing thread writes, a second fault just takes the default path
+    if (!s_crashing.exchange(true)) {
+        Line _reason;
+        _reason.append("Fatal signal ");
+        _reason.append_number(static_cast<uint64_t>(signal));
+        _reason.append(" (");
+        _reason.append(signal_name(signal));
+        _reason.append(")");
+        write_pending(_reason.view());
+    } // end if (!s_crashing.exchange(true))
+    //--------------------------
+    for (size_t i = 0; i < SIGNAL_COUNT; ++i) {
+        if (FATAL_SIGNALS[i] == signal) {
+            struct sigaction _previous = s_previous[i];
+            if (_previous.sa_handler == SIG_IGN) {
+                _previous.sa_handler = SIG_DFL;
+            } // end if (_previous.sa_handler == SIG_IGN)
+            sigaction(signal, &_previous, nullptr);
+        } // end if (FATAL_SIGNALS[i] == signal)
+    } // end for (size_t i = 0; i < SIGNAL_COUNT; ++i)
+    //--------------------------
+    // Delivered with the previous disposition once this handler returns
+    errno = _errno;
+    raise(signal);
+    //--------------------------
+} // end void Logger::CrashHandler::handle_signal(int signal)
+//--------------------------------------------------------------
+void Logger::CrashHandler::handle_terminate(void) {
+    //--------------------------
+    if (!s_crashing.exchange(true)) {
+        //--------------------------
+        Line _reason;
+        _reason.append("std::terminate called");
+        //--------------------------
+        if (const std::exception_ptr _exception = std::current_exception()) {
+            try {
+                std::rethrow_exception(_exception);
+            } catch (const std::exception& e) {
+                _reason.append(" after throwing: ");
+                _reason.append(e.what());
+            } catch (...) {
+                _reason.append(" after throwing a non-standard exception");
+            } // end try
+        } // end if (const std::exception_ptr _exception = std::current_exception())
+        //--------------------------
+        write_pending(_reason.view());
+        //--------------------------
+    } // end if (!s_crashing.exchange(true))
+    //--------------------------
+    if (s_previous_terminate) {
+        s_previous_terminate();
+    } // end if (s_previous_terminate)
+    std::abort();
+    //--------------------------
+} // end void Logger::CrashHandler::handle_terminate(void)
+//--------------------------------------------------------------
+void Logger::CrashHandler::write_pending(std::string_view reason) noexcept {
+    //--------------------------
+    Logger& _logger = Logger::instance();
+    //--------------------------
+    // Lines that were already formatted are the oldest
+    for (const auto& _entry : _logger.m_sinks) {
+        _entry.sink->write_pending();
+    } // end for (const auto& _entry : _logger.m_sinks)
+    //--------------------------
+    // Then the records the writer thread has not taken yet, ring by ring
+    Line _line;
+    const auto _assemble = [&_line](const LogRecord& record) {
+        _line.size = 0UL;
+        _line.append_time(record.time);
+        _line.append(level_tag(record.level));
+        if (record.format.empty()) {
+            _line.append(record.message);
+        } else {
+            _line.append(record.format);
+            _line.append(" (arguments not rendered)");
+        } // end if (record.format.empty())
+        _line.append("\n");
+    };
+    //--------------------------
+    for (const auto& _queue : _logger.m_queues) {
+        _queue->queue.visit([&](const LogRecord& record) {
+            //--------------------------
+            _assemble(record);
+            //--------------------------
+#ifndef DEBUG
+            if (record.level != LogLevel::DEBUG)
+#endif
+            write_all(_logger.m_console->descriptor(record.level), _line.view());
+            //--------------------------
+            if (record.level == LogLevel::ERROR) {
+                write_all(_logger.m_error_file->descriptor(), _line.view());
+            } else if (record.level == LogLevel::WARNING) {
+                write_all(_logger.m_warning_file->descriptor(), _line.view());
+            } // end if (record.level == LogLevel::ERROR)
+            //--------------------------
+        });
+    } // end for (const auto& _queue : _logger.m_queues)
+    //--------------------------
+    // Then what the flight recorders still hold, routed like an ERROR; the owning threads may be mid-write
+    const size_t _dump_records = _logger.m_flight_dump_records.load(std::memory_order_relaxed);
+    for (const auto& _recorder : _logger.m_recorders) {
+        const uint64_t _end = _recorder->end();
+        for (uint64_t _sequence = _recorder->begin(_dump_records, _end); _sequence != _end; ++_sequence) {
+            //--------------------------
+            _assemble(_recorder->at(_sequence));
+            write_all(_logger.m_console->descriptor(LogLevel::ERROR), _line.view());
+            write_all(_logger.m_error_file->descriptor(), _line.view());
+            //--------------------------
+        } // end for (uint64_t _sequence = _recorder->begin(_dump_records, _end); _sequence != _end; ++_sequence)
+    } // end for (const auto& _recorder : _logger.m_recorders)
+    //--------------------------
+    _line.size = 0UL;
+    _line.append_time(std::chrono::system_clock::now());
+    _line.append(" [CRASH]: ");
+    _line.append(reason);
+    _line.append("\n");
+    //--------------------------
+    write_all(STDERR_FILENO, _line.view());
+    write_all(_logger.m_error_file->descriptor(), _line.view());
+    write_all(_logger.m_warning_file->descriptor(), _line.view());
+    //--------------------------
+} // end void Logger::CrashHandler::write_pending(std::string_view reason) noexcept
+//--------------------------------------------------------------
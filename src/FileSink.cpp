@@ -0,0 +1,308 @@
+//--------------------------------------------------------------
+// Main Header
+//--------------------------------------------------------------
+#include "FileSink.hpp"
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <utility>
+//--------------------------------------------------------------
+#if defined(_WIN32)
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+//--------------------------------------------------------------
+#if __cpp_lib_format
+    #include <format>
+#else
+    #include <fmt/core.h>
+    #include <fmt/chrono.h>
+#endif
+//--------------------------------------------------------------
+Logger::FileSink::FileSink(std::string filename, const FileSinkOptions& options) :  m_filename(std::move(filename)),
+                                                                                    m_options(options),
+                                                                                    m_file(nullptr),
+                                                                                    m_descriptor(-1),
+                                                                                    m_last_commit(std::chrono::steady_clock::now()),
+                                                                                    m_created(std::chrono::system_clock::now()),
+                                                                                    m_batching(false),
+                                                                                    m_size(0UL),
+                                                                                    m_lost_bytes(0UL),
+                                                                                    m_write_failed(false),
+                                                                                    m_generation(0U) {
+    //--------------------------
+    m_buffer.reserve(m_options.buffer_size);
+    //--------------------------
+} // end Logger::FileSink::FileSink(std::string filename, const FileSinkOptions& options)
+//--------------------------------------------------------------
+Logger::FileSink::~FileSink(void) {
+    //--------------------------
+    flush();
+    //--------------------------
+    if (m_file) {
+        std::fclose(m_file);
+    } // end if (m_file)
+    //--------------------------
+} // end Logger::FileSink::~FileSink(void)
+//--------------------------------------------------------------
+void Logger::FileSink::write(const LogRecord& record, std::string_view formatted) {
+    static_cast<void>(record);
+    write(formatted);
+} // end void Logger::FileSink::write(const LogRecord& record, std::string_view formatted)
+//--------------------------------------------------------------
+void Logger::FileSink::write(std::string_view message) {
+    //--------------------------
+    m_buffer.append(message);
+    m_buffer.push_back('\n');
+    //--------------------------
+    // Without batching nothing polls the sink, a line left in the buffer could wait until exit
+    if (m_buffer.size() >= m_options.buffer_size || (!m_batching && m_options.durability != Durability::NONE)) {
+        commit();
+    } else if (m_options.durability != Durability::NONE) {
+        poll(std::chrono::steady_clock::now());
+    } // end if (m_buffer.size() >= m_options.buffer_size || ...)
+    //--------------------------
+} // end void Logger::FileSink::write(std::string_view message)
+//--------------------------------------------------------------
+void Logger::FileSink::write_raw(std::string_view data) {
+    //--------------------------
+    m_buffer.append(data);
+    //--------------------------
+    // Without batching nothing polls the sink, a line left in the buffer could wait until exit
+    if (m_buffer.size() >= m_options.buffer_size || (!m_batching && m_options.durability != Durability::NONE)) {
+        commit();
+    } else if (m_options.durability != Durability::NONE) {
+        poll(std::chrono::steady_clock::now());
+    } // end if (m_buffer.size() >= m_options.buffer_size || ...)
+    //--------------------------
+} // end void Logger::FileSink::write_raw(std::string_view data)
+//--------------------------------------------------------------
+void Logger::FileSink::flush(void) {
+    commit();
+} // end void Logger::FileSink::flush(void)
+//--------------------------------------------------------------
+void Logger::FileSink::poll(const std::chrono::steady_clock::time_point& now) {
+    //--------------------------
+    if (m_options.durability != Durability::NONE && !m_buffer.empty() &&
+        now - m_last_commit >= m_options.flush_interval) {
+        commit();
+    } // end if (m_options.durability != Durability::NONE && ...)
+    //--------------------------
+} // end void Logger::FileSink::poll(const std::chrono::steady_clock::time_point& now)
+//--------------------------------------------------------------
+void Logger::FileSink::set_batching(const bool& enabled) {
+    //--------------------------
+    if (!enabled) {
+        commit();
+    } // end if (!enabled)
+    m_batching = enabled;
+    //--------------------------
+} // end void Logger::FileSink::set_batching(const bool& enabled)
+//--------------------------------------------------------------
+void Logger::FileSink::set_options(const FileSinkOptions& options) {
+    //--------------------------
+    commit();
+    m_options = options;
+    m_buffer.reserve(m_options.buffer_size);
+    schedule_rotation(std::chrono::system_clock::now());
+    //--------------------------
+} // end void Logger::FileSink::set_options(const FileSinkOptions& options)
+//--------------------------------------------------------------
+const std::string& Logger::FileSink::filename(void) const {
+    return m_filename;
+} // end const std::string& Logger::FileSink::filename(void) const
+//--------------------------------------------------------------
+void Logger::FileSink::preopen(void) {
+    open();
+} // end void Logger::FileSink::preopen(void)
+//--------------------------------------------------------------
+void Logger::FileSink::write_pending(std::string_view line) noexcept {
+    //--------------------------
+    if (m_descriptor < 0) {
+        return;
+    } // end if (m_descriptor < 0)
+    //--------------------------
+    for (std::string_view _data : {std::string_view(m_buffer), line}) {
+        while (!_data.empty()) {
+#if defined(_WIN32)
+            const int _written = _write(m_descriptor, _data.data(), static_cast<unsigned int>(_data.size()));
+#else
+            const ssize_t _written = ::write(m_descriptor, _data.data(), _data.size());
+#endif
+            if (_written < 0 && errno == EINTR) {
+                continue;
+            } // end if (_written < 0 && errno == EINTR)
+            if (_written <= 0) {
+                return;
+            } // end if (_written <= 0)
+            _data.remove_prefix(static_cast<size_t>(_written));
+        } // end while (!_data.empty())
+    } // end for (std::string_view _data : {std::string_view(m_buffer), line})
+    //--------------------------
+    m_buffer.clear();
+    //--------------------------
+} // end void Logger::FileSink::write_pending(std::string_view line) noexcept
+//--------------------------------------------------------------
+void Logger::FileSink::write_pending(void) noexcept {
+    write_pending(std::string_view());
+} // end void Logger::FileSink::write_pending(void) noexcept
+//--------------------------------------------------------------
+int Logger::FileSink::descriptor(void) const {
+    return m_descriptor;
+} // end int Logger::FileSink::descriptor(void) const
+//--------------------------------------------------------------
+uint64_t Logger::FileSink::lost_bytes(void) const {
+    return m_lost_bytes.load(std::memory_order_relaxed);
+} // end uint64_t Logger::FileSink::lost_bytes(void) const
+//--------------------------------------------------------------
+std::string Logger::FileSink::header(const std::chrono::system_clock::time_point& created) {
+    //--------------------------
+    const auto localtime = std::chrono::system_clock::to_time_t(created);
+    //--------------------------
+#if __cpp_lib_format
+    return std::format("Log file created at: {:%Y-%m-%d %H:%M:%S}\n", *std::localtime(&localtime));
+#else
+    return fmt::format("Log file created at: {:%Y-%m-%d %H:%M:%S}\n", fmt::localtime(localtime));
+#endif
+    //--------------------------
+} // end std::string Logger::FileSink::header(const std::chrono::system_clock::time_point& created)
+//--------------------------------------------------------------
+bool Logger::FileSink::open(void) {
+    //--------------------------
+    if (m_file) {
+        return true;
+    } // end if (m_file)
+    //--------------------------
+    m_file = std::fopen(m_filename.c_str(), "ab");
+    if (!m_file) {
+        return false;
+    } // end if (!m_file)
+    //--------------------------
+    // The sink does its own buffering, stdio should hand every commit straight to the OS
+    std::setvbuf(m_file, nullptr, _IONBF, 0);
+#if defined(_WIN32)
+    m_descriptor = _fileno(m_file);
+#else
+    m_descriptor = fileno(m_file);
+#endif
+    //--------------------------
+    std::fseek(m_file, 0, SEEK_END);
+    m_size = static_cast<uint64_t>(std::ftell(m_file));
+    schedule_rotation(std::chrono::system_clock::now());
+    //--------------------------
+    // Stamped when the sink was made, not when the lazy open happens to run
+    if (m_options.header && !m_size) { // Check if the file is empty
+        m_buffer.insert(0, header(m_created));
+    } // end if (m_options.header && !m_size)
+    //--------------------------
+    return true;
+    //--------------------------
+} // end bool Logger::FileSink::open(void)
+//--------------------------------------------------------------
+void Logger::FileSink::commit(void) {
+    //--------------------------
+    m_last_commit = std::chrono::steady_clock::now();
+    //--------------------------
+    if (m_buffer.empty() || !open()) {
+        return;
+    } // end if (m_buffer.empty() || !open())
+    //--------------------------
+    if (rotation_due(std::chrono::system_clock::now())) {
+        rotate();
+        if (!open()) {
+            return;
+        } // end if (!open())
+    } // end if (rotation_due(std::chrono::system_clock::now()))
+    //--------------------------
+    size_t _written = 0UL;
+    while (_written < m_buffer.size()) {
+        errno = 0;
+        const size_t _count = std::fwrite(m_buffer.data() + _written, 1, m_buffer.size() - _written, m_file);
+        _written += _count;
+        if (_count == 0UL && errno != EINTR) {
+            break;
+        } // end if (_count == 0UL && errno != EINTR)
+        std::clearerr(m_file);
+    } // end while (_written < m_buffer.size())
+    m_size += _written;
+    //--------------------------
+    // A full disk or an I/O error loses the rest of the batch; reported once until a commit succeeds again
+    if (LOGGER_UNLIKELY(_written < m_buffer.size())) {
+        const int _error = errno;
+        std::clearerr(m_file);
+        m_lost_bytes.fetch_add(m_buffer.size() - _written, std::memory_order_relaxed);
+        if (!m_write_failed) {
+            m_write_failed = true;
+            std::fprintf(stderr, "Logger: writing %s failed (%s), %zu bytes lost\n", m_filename.c_str(), std::strerror(_error),
+                         m_buffer.size() - _written);
+        } // end if (!m_write_failed)
+    } else {
+        m_write_failed = false;
+    } // end if (LOGGER_UNLIKELY(_written < m_buffer.size()))
+    m_buffer.clear();
+    //--------------------------
+    if (m_options.durability == Durability::FDATASYNC) {
+#if defined(_WIN32)
+        _commit(_fileno(m_file));
+#elif defined(__APPLE__)
+        fsync(fileno(m_file));
+#else
+        fdatasync(fileno(m_file));
+#endif
+    } // end if (m_options.durability == Durability::FDATASYNC)
+    //--------------------------
+} // end void Logger::FileSink::commit(void)
+//--------------------------------------------------------------
+bool Logger::FileSink::rotation_due(const std::chrono::system_clock::time_point& now) const {
+    //--------------------------
+    // Never rotate into an empty generation
+    if (!m_size) {
+        return false;
+    } // end if (!m_size)
+    //--------------------------
+    if (m_options.max_size && m_size + m_buffer.size() > m_options.max_size) {
+        return true;
+    } // end if (m_options.max_size && m_size + m_buffer.size() > m_options.max_size)
+    //--------------------------
+    return m_options.rotation_interval.count() > 0 && now >= m_next_rotation;
+    //--------------------------
+} // end bool Logger::FileSink::rotation_due(const std::chrono::system_clock::time_point& now) const
+//--------------------------------------------------------------
+void Logger::FileSink::rotate(void) {
+    //--------------------------
+    std::fclose(m_file);
+    m_file          = nullptr;
+    m_descriptor    = -1;
+    m_size          = 0UL;
+    //--------------------------
+    if (!m_compressor) {
+        m_compressor = Compressor::shared();
+        m_generation = Compressor::last_generation(m_filename);
+    } // end if (!m_compressor)
+    //--------------------------
+    // A single rename is atomic, existing generations keep their names so the compressor never races it
+    const std::string _rotated = Compressor::generation_path(m_filename, ++m_generation);
+    if (std::rename(m_filename.c_str(), _rotated.c_str()) != 0) {
+        return; // Keep appending to the current file
+    } // end if (std::rename(m_filename.c_str(), _rotated.c_str()) != 0)
+    //--------------------------
+    m_created = std::chrono::system_clock::now();
+    m_compressor->submit(m_filename, m_generation, m_options.max_files, m_options.compression);
+    //--------------------------
+} // end void Logger::FileSink::rotate(void)
+//--------------------------------------------------------------
+void Logger::FileSink::schedule_rotation(const std::chrono::system_clock::time_point& now) {
+    //--------------------------
+    if (m_options.rotation_interval.count() <= 0) {
+        return;
+    } // end if (m_options.rotation_interval.count() <= 0)
+    //--------------------------
+    const auto _elapsed = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch());
+    m_next_rotation     = std::chrono::system_clock::time_point(_elapsed - _elapsed % m_options.rotation_interval + m_options.rotation_interval);
+    //--------------------------
+} // end void Logger::FileSink::schedule_rotation(const std::chrono::system_clock::time_point& now)
+//--------------------------------------------------------------
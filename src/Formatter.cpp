@@ -0,0 +1,23 @@
+//--------------------------------------------------------------
+// Main Header
+//--------------------------------------------------------------
+#include "Formatter.hpp"
+//--------------------------------------------------------------
+// Logger library
+//--------------------------------------------------------------
+#include "KeyValue.hpp"
+#include "Timestamp.hpp"
+//--------------------------------------------------------------
+void Logger::TextFormatter::format(const LogRecord& record, std::string& output) {
+    //--------------------------
+    char _timestamp[Timestamp::MAX_LENGTH];
+    const size_t _length = Timestamp::format(record.time, _timestamp);
+    //--------------------------
+    output.clear();
+    output.append(_timestamp, _length).append(level_tag(record.level)).append(record.message);
+    if (record.site) {
+        record.site->append_text(output, record.fields);
+    } // end if (record.site)
+    //--------------------------
+} // end void Logger::TextFormatter::format(const LogRecord& record, std::string& output)
+//--------------------------------------------------------------
@@ -0,0 +1,165 @@
+//--------------------------------------------------------------
+// Main Header
+//--------------------------------------------------------------
+#include "JsonSink.hpp"
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <charconv>
+#include <ctime>
+#include <functional>
+#include <utility>
+//--------------------------------------------------------------
+// Logger library
+//--------------------------------------------------------------
+#include "KeyValue.hpp"
+//--------------------------------------------------------------
+namespace {
+    //--------------------------------------------------------------
+    Logger::FileSinkOptions json_options(Logger::FileSinkOptions options) {
+        options.header = false; // Every line has to parse
+        return options;
+    } // end Logger::FileSinkOptions json_options(Logger::FileSinkOptions options)
+    //--------------------------------------------------------------
+} // end namespace
+//--------------------------------------------------------------
+Logger::JsonSink::JsonSink(std::string filename, const FileSinkOptions& options) :  m_file(std::move(filename), json_options(options)),
+                                                                                    m_second(INT64_MIN) {
+    //--------------------------
+    // Opened up front so write_pending() has a descriptor even before the first commit
+    m_file.preopen();
+    //--------------------------
+} // end Logger::JsonSink::JsonSink(std::string filename, const FileSinkOptions& options)
+//--------------------------------------------------------------
+Logger::JsonSink::~JsonSink(void) {
+    m_file.flush();
+} // end Logger::JsonSink::~JsonSink(void)
+//--------------------------------------------------------------
+void Logger::JsonSink::write(const LogRecord& record, std::string_view formatted) {
+    //--------------------------
+    static_cast<void>(formatted);
+    //--------------------------
+    m_line.assign("{\"time\":\"");
+    append_time(record.time);
+    m_line.append(site(record));
+    //--------------------------
+    char _thread[24];
+    const auto _result = std::to_chars(_thread, _thread + sizeof(_thread), record.thread);
+    m_line.append(_thread, _result.ptr);
+    //--------------------------
+    m_line.append(",\"message\":\"");
+    Json::escape(m_line, record.message);
+    m_line.push_back('"');
+    //--------------------------
+    if (record.site) {
+        record.site->append_json(m_line, record.fields);
+    } // end if (record.site)
+    m_line.push_back('}');
+    //--------------------------
+    m_file.write(m_line);
+    //--------------------------
+} // end void Logger::JsonSink::write(const LogRecord& record, std::string_view formatted)
+//--------------------------------------------------------------
+void Logger::JsonSink::flush(void) {
+    m_file.flush();
+} // end void Logger::JsonSink::flush(void)
+//--------------------------------------------------------------
+void Logger::JsonSink::poll(const std::chrono::steady_clock::time_point& now) {
+    m_file.poll(now);
+} // end void Logger::JsonSink::poll(const std::chrono::steady_clock::time_point& now)
+//--------------------------------------------------------------
+void Logger::JsonSink::set_batching(const bool& enabled) {
+    m_file.set_batching(enabled);
+} // end void Logger::JsonSink::set_batching(const bool& enabled)
+//--------------------------------------------------------------
+void Logger::JsonSink::write_pending(void) noexcept {
+    m_file.write_pending(std::string_view());
+} // end void Logger::JsonSink::write_pending(void) noexcept
+//--------------------------------------------------------------
+size_t Logger::JsonSink::SiteKeyHash::operator()(const SiteKey& key) const {
+    //--------------------------
+    size_t _hash = std::hash<const void*>()(key.file);
+    _hash ^= std::hash<uint64_t>()((static_cast<uint64_t>(key.line) << 8U) | static_cast<uint64_t>(key.level)) + 0x9e3779b97f4a7c15ULL + (_hash << 6U) + (_hash >> 2U);
+    //--------------------------
+    return _hash;
+    //--------------------------
+} // end size_t Logger::JsonSink::SiteKeyHash::operator()(const SiteKey& key) const
+//--------------------------------------------------------------
+const std::string& Logger::JsonSink::site(const LogRecord& record) {
+    //--------------------------
+    const SiteKey _key{record.file, record.line, record.level};
+    //--------------------------
+    auto _site = m_sites.find(_key);
+    if (_site != m_sites.end()) {
+        return _site->second;
+    } // end if (_site != m_sites.end())
+    //--------------------------
+    std::string _encoded("\",\"level\":\"");
+    _encoded.append(level_name(record.level)).push_back('"');
+    if (record.file) {
+        _encoded.append(",\"file\":\"");
+        Json::escape(_encoded, record.file);
+        _encoded.append("\",\"line\":");
+        Json::encode(_encoded, record.line);
+    } // end if (record.file)
+    _encoded.append(",\"thread\":");
+    //--------------------------
+    return m_sites.emplace(_key, std::move(_encoded)).first->second;
+    //--------------------------
+} // end const std::string& Logger::JsonSink::site(const LogRecord& record)
+//--------------------------------------------------------------
+void Logger::JsonSink::append_time(const std::chrono::system_clock::time_point& time) {
+    //--------------------------
+    const int64_t _nanoseconds  = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    int64_t _second             = _nanoseconds / 1'000'000'000L;
+    int64_t _fraction           = _nanoseconds % 1'000'000'000L;
+    if (_fraction < 0) {
+        _fraction += 1'000'000'000L;
+        --_second;
+    } // end if (_fraction < 0)
+    //--------------------------
+    // "YYYY-MM-DDTHH:MM:SS", rebuilt only when the second changes
+    if (_second != m_second) {
+        //--------------------------
+        const auto _time = static_cast<std::time_t>(_second);
+        std::tm _utc{};
+#if defined(_WIN32)
+        gmtime_s(&_utc, &_time);
+#else
+        gmtime_r(&_time, &_utc);
+#endif
+        //--------------------------
+        Timestamp::write_digits(m_date, static_cast<uint64_t>(_utc.tm_year + 1900), 4UL);
+        m_date[4] = '-';
+        Timestamp::write_digits(m_date + 5, static_cast<uint64_t>(_utc.tm_mon + 1), 2UL);
+        m_date[7] = '-';
+        Timestamp::write_digits(m_date + 8, static_cast<uint64_t>(_utc.tm_mday), 2UL);
+        m_date[10] = 'T';
+        Timestamp::write_digits(m_date + 11, static_cast<uint64_t>(_utc.tm_hour), 2UL);
+        m_date[13] = ':';
+        Timestamp::write_digits(m_date + 14, static_cast<uint64_t>(_utc.tm_min), 2UL);
+        m_date[16] = ':';
+        Timestamp::write_digits(m_date + 17, static_cast<uint64_t>(_utc.tm_sec), 2UL);
+        //--------------------------
+        m_second = _second;
+        //--------------------------
+    } // end if (_second != m_second)
+    //--------------------------
+    m_line.append(m_date, Timestamp::SECONDS_LENGTH);
+    //--------------------------
+    // Same sub-second digits as the text output
+    const auto _digits = static_cast<size_t>(Timestamp::precision());
+    if (_digits) {
+        uint64_t _value = static_cast<uint64_t>(_fraction);
+        for (size_t i = _digits; i < 9UL; ++i) {
+            _value /= 10UL;
+        } // end for (size_t i = _digits; i < 9UL; ++i)
+        char _buffer[10];
+        _buffer[0] = '.';
+        Timestamp::write_digits(_buffer + 1, _value, _digits);
+        m_line.append(_buffer, _digits + 1UL);
+    } // end if (_digits)
+    m_line.push_back('Z');
+    //--------------------------
+} // end void Logger::JsonSink::append_time(const std::chrono::system_clock::time_point& time)
+//--------------------------------------------------------------
@@ -0,0 +1,88 @@
+//--------------------------------------------------------------
+// Main Header
+//--------------------------------------------------------------
+#include "KeyValue.hpp"
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <array>
+#include <cstdint>
+//--------------------------------------------------------------
+namespace {
+    //--------------------------------------------------------------
+    // **Escape sequence per byte, empty for bytes copied as they are**
+    //--------------------------------------------------------------
+    constexpr std::array<std::string_view, 256> make_escapes(void) {
+        //--------------------------
+        constexpr std::string_view CONTROL[32] = {
+            "\\u0000", "\\u0001", "\\u0002", "\\u0003", "\\u0004", "\\u0005", "\\u0006", "\\u0007",
+            "\\b",     "\\t",     "\\n",     "\\u000b", "\\f",     "\\r",     "\\u000e", "\\u000f",
+            "\\u0010", "\\u0011", "\\u0012", "\\u0013", "\\u0014", "\\u0015", "\\u0016", "\\u0017",
+            "\\u0018", "\\u0019", "\\u001a", "\\u001b", "\\u001c", "\\u001d", "\\u001e", "\\u001f"
+        };
+        //--------------------------
+        std::array<std::string_view, 256> _escapes{};
+        for (size_t i = 0; i < 32UL; ++i) {
+            _escapes[i] = CONTROL[i];
+        } // end for (size_t i = 0; i < 32UL; ++i)
+        _escapes[static_cast<uint8_t>('"')]     = "\\\"";
+        _escapes[static_cast<uint8_t>('\\')]    = "\\\\";
+        //--------------------------
+        return _escapes;
+        //--------------------------
+    } // end constexpr std::array<std::string_view, 256> make_escapes(void)
+    //--------------------------------------------------------------
+    constexpr std::array<std::string_view, 256> ESCAPES = make_escapes();
+    //--------------------------------------------------------------
+} // end namespace
+//--------------------------------------------------------------
+void Logger::Json::escape(std::string& output, std::string_view text) {
+    //--------------------------
+    size_t _run = 0UL; // Start of the bytes not copied yet
+    //--------------------------
+    for (size_t i = 0; i < text.size(); ++i) {
+        const std::string_view _escape = ESCAPES[static_cast<uint8_t>(text[i])];
+        if (LOGGER_LIKELY(_escape.empty())) {
+            continue;
+        } // end if (LOGGER_LIKELY(_escape.empty()))
+        output.append(text.data() + _run, i - _run).append(_escape);
+        _run = i + 1UL;
+    } // end for (size_t i = 0; i < text.size(); ++i)
+    //--------------------------
+    output.append(text.data() + _run, text.size() - _run);
+    //--------------------------
+} // end void Logger::Json::escape(std::string& output, std::string_view text)
+//--------------------------------------------------------------
+void Logger::KeyValueSite::append_text(std::string& output, std::string_view fields) const {
+    //--------------------------
+    for (const std::string& _key : m_text_keys) {
+        const size_t _end = fields.find('\0');
+        output.append(_key).append(fields.substr(0UL, _end));
+        fields.remove_prefix(_end == std::string_view::npos ? fields.size() : _end + 1UL);
+    } // end for (const std::string& _key : m_text_keys)
+    //--------------------------
+} // end void Logger::KeyValueSite::append_text(std::string& output, std::string_view fields) const
+//--------------------------------------------------------------
+void Logger::KeyValueSite::append_json(std::string& output, std::string_view fields) const {
+    //--------------------------
+    for (const std::string& _key : m_json_keys) {
+        const size_t _end = fields.find('\0');
+        output.append(_key).append(fields.substr(0UL, _end));
+        fields.remove_prefix(_end == std::string_view::npos ? fields.size() : _end + 1UL);
+    } // end for (const std::string& _key : m_json_keys)
+    //--------------------------
+} // end void Logger::KeyValueSite::append_json(std::string& output, std::string_view fields) const
+//--------------------------------------------------------------
+void Logger::KeyValueSite::add_key(std::string_view key) {
+    //--------------------------
+    std::string _text(" ");
+    _text.append(key).push_back('=');
+    m_text_keys.push_back(std::move(_text));
+    //--------------------------
+    std::string _json(",\"");
+    Json::escape(_json, key);
+    _json.append("\":");
+    m_json_keys.push_back(std::move(_json));
+    //--------------------------
+} // end void Logger::KeyValueSite::add_key(std::string_view key)
+//--------------------------------------------------------------
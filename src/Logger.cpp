@@ -5,120 +5,1404 @@
 //--------------------------------------------------------------
 // Standard cpp library
 //--------------------------------------------------------------
-#include <fstream>
-#include <sstream>
 #include <string>
 #include <string_view>
-#include <iomanip>
-#include <ctime>
+#include <unordered_map>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
 //--------------------------------------------------------------
-// Definitions
+#if defined(__linux__)
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
 //--------------------------------------------------------------
-#if __cpp_lib_format
-    #define ANSI_COLOR_RED              "\x1b[31m"
-    #define ANSI_COLOR_YELLOW           "\x1b[33m"
-    #define ANSI_COLOR_RESET            "\x1b[0m"
-#endif 
+namespace {
+    //--------------------------------------------------------------
+    // **Marks the thread's ring closed on thread exit so the writer can drop it once drained**
+    //--------------------------------------------------------------
+    struct ThreadQueueHandle {
+        std::shared_ptr<Logger::ThreadQueue> queue;
+        //--------------------------
+        ~ThreadQueueHandle(void) {
+            if (queue) {
+                queue->closed.store(true, std::memory_order_release);
+            } // end if (queue)
+        } // end ~ThreadQueueHandle(void)
+    }; // end struct ThreadQueueHandle
+    //--------------------------------------------------------------
+    thread_local ThreadQueueHandle t_queue;
+    //--------------------------------------------------------------
+    // **Marks the thread's metrics shard closed on thread exit so a snapshot can fold it into the totals**
+    //--------------------------------------------------------------
+    struct MetricsShardHandle {
+        std::shared_ptr<Logger::MetricsShard> shard;
+        //--------------------------
+        ~MetricsShardHandle(void) {
+            if (shard) {
+                shard->closed.store(true, std::memory_order_release);
+            } // end if (shard)
+        } // end ~MetricsShardHandle(void)
+    }; // end struct MetricsShardHandle
+    //--------------------------------------------------------------
+    thread_local MetricsShardHandle t_shard;
+    //--------------------------------------------------------------
+    // **Marks the thread's flight recorder closed on thread exit so the next registration drops it**
+    //--------------------------------------------------------------
+    struct FlightRecorderHandle {
+        std::shared_ptr<Logger::FlightRecorder> recorder;
+        //--------------------------
+        ~FlightRecorderHandle(void) {
+            if (recorder) {
+                recorder->closed.store(true, std::memory_order_release);
+            } // end if (recorder)
+        } // end ~FlightRecorderHandle(void)
+    }; // end struct FlightRecorderHandle
+    //--------------------------------------------------------------
+    thread_local FlightRecorderHandle t_recorder;
+    //--------------------------------------------------------------
+    // **Marks the thread's trace buffer closed on thread exit so a drain can drop it once empty**
+    //--------------------------------------------------------------
+    struct TraceQueueHandle {
+        std::shared_ptr<Logger::TraceQueue> queue;
+        //--------------------------
+        ~TraceQueueHandle(void) {
+            if (queue) {
+                queue->closed.store(true, std::memory_order_release);
+            } // end if (queue)
+        } // end ~TraceQueueHandle(void)
+    }; // end struct TraceQueueHandle
+    //--------------------------------------------------------------
+    thread_local TraceQueueHandle t_trace_queue;
+    //--------------------------------------------------------------
+    uint64_t nanoseconds_since(const std::chrono::steady_clock::time_point& start) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    } // end uint64_t nanoseconds_since(const std::chrono::steady_clock::time_point& start)
+    //--------------------------------------------------------------
+} // end namespace
+//--------------------------------------------------------------
+Logger::ScratchBuffer::Slot& Logger::ScratchBuffer::slot(void) {
+    //--------------------------
+    thread_local Slot t_slot = [] {
+        Slot _slot;
+        _slot.text.reserve(INITIAL_CAPACITY);
+        return _slot;
+    }();
+    //--------------------------
+    return t_slot;
+    //--------------------------
+} // end Logger::ScratchBuffer::Slot& Logger::ScratchBuffer::slot(void)
 //--------------------------------------------------------------
 Logger::Logger& Logger::Logger::instance(void) {
     static Logger instance;
     return instance;
 } // end Logger& Logger::instance(void)
 //--------------------------------------------------------------
-void Logger::Logger::level_message(const LogLevel& level, std::string_view message) const {
+void Logger::Logger::set_level(const LogLevel& minimum) {
+    s_level_mask.store(level_mask(minimum), std::memory_order_relaxed);
+} // end void Logger::Logger::set_level(const LogLevel& minimum)
+//--------------------------------------------------------------
+Logger::Category& Logger::Logger::category(std::string_view name) {
+    //--------------------------
+    static std::mutex s_mutex;
+    static std::unordered_map<std::string, std::unique_ptr<Category>> s_categories;
     //--------------------------
-    switch (level) {
-        case LogLevel::DEBUG:
+    std::lock_guard<std::mutex> lock(s_mutex);
+    //--------------------------
+    auto& _category = s_categories[std::string(name)];
+    if (!_category) {
+        _category = std::make_unique<Category>(std::string(name));
+    } // end if (!_category)
+    //--------------------------
+    return *_category;
+    //--------------------------
+} // end Logger::Category& Logger::Logger::category(std::string_view name)
+//--------------------------------------------------------------
+void Logger::Logger::set_category_level(std::string_view name, const LogLevel& minimum) {
+    category(name).set_level(minimum);
+} // end void Logger::Logger::set_category_level(std::string_view name, const LogLevel& minimum)
+//--------------------------------------------------------------
+void Logger::Logger::reset_category_level(std::string_view name) {
+    category(name).reset();
+} // end void Logger::Logger::reset_category_level(std::string_view name)
+//--------------------------------------------------------------
+Logger::Logger::Logger(void) : m_console(std::make_shared<ConsoleSink>()),
+                               m_error_file(std::make_shared<FileSink>("error_log.txt")),
+                               m_warning_file(std::make_shared<FileSink>("warning_log.txt")) {
+    //--------------------------
+    m_formatters.push_back(FormatterSlot{std::make_shared<TextFormatter>(), std::string(), false});
+    //--------------------------
+    // The routing the logger always had
+    uint8_t _console = level_mask(LogLevel::INFO);
 #ifdef DEBUG
-#if __cpp_lib_format
-            std::print("{}\n", message);
-#else
-            fmt::print("{}\n", message);
-#endif
+    _console |= static_cast<uint8_t>(LogLevel::DEBUG);
 #endif
+    m_sinks.push_back(SinkEntry{m_console, _console, 0UL, SinkMetrics{.name = "console"}});
+    m_sinks.push_back(SinkEntry{m_error_file, static_cast<uint8_t>(LogLevel::ERROR), 0UL, SinkMetrics{.name = "error_log"}});
+    m_sinks.push_back(SinkEntry{m_warning_file, static_cast<uint8_t>(LogLevel::WARNING), 0UL, SinkMetrics{.name = "warning_log"}});
+    //--------------------------
+} // end Logger::Logger::Logger(void)
+//--------------------------------------------------------------
+Logger::Logger::~Logger(void) {
+    //--------------------------
+    stop_async();
+    //--------------------------
+    std::lock_guard<std::mutex> lock(m_mutex);
+    flush_files();
+    //--------------------------
+} // end Logger::Logger::~Logger(void)
+//--------------------------------------------------------------
+void Logger::Logger::start_async(const size_t& capacity) {
+    //--------------------------
+    std::lock_guard<std::mutex> lock(m_control_mutex);
+    //--------------------------
+    if (m_running.load(std::memory_order_acquire)) {
+        return;
+    } // end if (m_running.load(std::memory_order_acquire))
+    //--------------------------
+    // Applies to rings created from now on, threads that already logged keep theirs
+    m_queue_capacity.store(capacity, std::memory_order_relaxed);
+    //--------------------------
+    {
+        std::lock_guard<std::mutex> write_lock(m_mutex);
+        set_batching(true);
+    }
+    //--------------------------
+    m_running.store(true, std::memory_order_release);
+    m_writer = std::thread(&Logger::writer_loop, this);
+    m_async.store(true, std::memory_order_release);
+    //--------------------------
+} // end void Logger::Logger::start_async(const size_t& capacity)
+//--------------------------------------------------------------
+void Logger::Logger::stop_async(void) {
+    //--------------------------
+    std::lock_guard<std::mutex> lock(m_control_mutex);
+    //--------------------------
+    if (!m_running.load(std::memory_order_acquire)) {
+        return;
+    } // end if (!m_running.load(std::memory_order_acquire))
+    //--------------------------
+    // New messages take the synchronous path
+    m_async.store(false, std::memory_order_seq_cst);
+    //--------------------------
+    // Producers that saw the mode before it was cleared finish their enqueue; the writer keeps
+    // running meanwhile so that a producer blocked on a full ring gets room. A ring registered
+    // after the snapshot belongs to a thread that will see the mode cleared
+    std::vector<std::shared_ptr<ThreadQueue>> _queues;
+    {
+        std::lock_guard<std::mutex> queues_lock(m_queues_mutex);
+        _queues = m_queues;
+    }
+    //--------------------------
+    for (const auto& _queue : _queues) {
+        while (_queue->producing.load(std::memory_order_seq_cst)) {
+            wake_writer();
+            std::this_thread::yield();
+        } // end while (_queue->producing.load(std::memory_order_seq_cst))
+    } // end for (const auto& _queue : _queues)
+    //--------------------------
+    // The writer drains what is queued before exiting
+    m_running.store(false, std::memory_order_seq_cst);
+    wake_writer();
+    //--------------------------
+    if (m_writer.joinable()) {
+        m_writer.join();
+    } // end if (m_writer.joinable())
+    //--------------------------
+    drain_queue();
+    //--------------------------
+    {
+        std::lock_guard<std::mutex> write_lock(m_mutex);
+        report_drops();
+        set_batching(false);
+    }
+    //--------------------------
+} // end void Logger::Logger::stop_async(void)
+//--------------------------------------------------------------
+bool Logger::Logger::is_async(void) const {
+    return m_async.load(std::memory_order_acquire);
+} // end bool Logger::Logger::is_async(void) const
+//--------------------------------------------------------------
+void Logger::Logger::flush(void) {
+    //--------------------------
+    if (!m_running.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        flush_files();
+        return;
+    } // end if (!m_running.load(std::memory_order_acquire))
+    //--------------------------
+    const uint64_t _ticket = m_flush_requested.fetch_add(1UL, std::memory_order_seq_cst) + 1UL;
+    wake_writer();
+    //--------------------------
+    std::unique_lock<std::mutex> lock(m_flush_mutex);
+    m_flush_cv.wait(lock, [this, _ticket] {
+        return m_flush_completed.load(std::memory_order_acquire) >= _ticket ||
+               !m_running.load(std::memory_order_acquire);
+    });
+    //--------------------------
+} // end void Logger::Logger::flush(void)
+//--------------------------------------------------------------
+void Logger::Logger::set_deferred_formatting(const bool& enabled) {
+    m_deferred.store(enabled, std::memory_order_relaxed);
+} // end void Logger::Logger::set_deferred_formatting(const bool& enabled)
+//--------------------------------------------------------------
+bool Logger::Logger::is_deferred_formatting(void) const {
+    return m_deferred.load(std::memory_order_relaxed);
+} // end bool Logger::Logger::is_deferred_formatting(void) const
+//--------------------------------------------------------------
+void Logger::Logger::set_timestamp_precision(const TimestampPrecision& precision) {
+    Timestamp::set_precision(precision);
+} // end void Logger::Logger::set_timestamp_precision(const TimestampPrecision& precision)
+//--------------------------------------------------------------
+bool Logger::Logger::set_clock_source(const ClockSource& source) {
+    //--------------------------
+    if (source == ClockSource::TSC && !TscClock::is_calibrated() && !TscClock::calibrate()) {
+        return false;
+    } // end if (source == ClockSource::TSC && ...)
+    //--------------------------
+    m_clock_source.store(source, std::memory_order_relaxed);
+    //--------------------------
+    return true;
+    //--------------------------
+} // end bool Logger::Logger::set_clock_source(const ClockSource& source)
+//--------------------------------------------------------------
+void Logger::Logger::set_file_options(const FileSinkOptions& options) {
+    //--------------------------
+    std::lock_guard<std::mutex> lock(m_mutex);
+    //--------------------------
+    m_error_file->set_options(options);
+    m_warning_file->set_options(options);
+    //--------------------------
+} // end void Logger::Logger::set_file_options(const FileSinkOptions& options)
+//--------------------------------------------------------------
+void Logger::Logger::set_console_options(const ConsoleSinkOptions& options) {
+    //--------------------------
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_console->set_options(options);
+    //--------------------------
+} // end void Logger::Logger::set_console_options(const ConsoleSinkOptions& options)
+//--------------------------------------------------------------
+void Logger::Logger::set_deduplication(const std::chrono::milliseconds& window) {
+    //--------------------------
+    std::lock_guard<std::mutex> lock(m_mutex);
+    //--------------------------
+    flush_repeats();
+    m_dedup_window = window;
+    m_last_message.clear();
+    m_last_hash = 0UL;
+    //--------------------------
+} // end void Logger::Logger::set_deduplication(const std::chrono::milliseconds& window)
+//--------------------------------------------------------------
+void Logger::Logger::set_backpressure(const BackpressureOptions& options) {
+    //--------------------------
+    m_backpressure[level_index(LogLevel::ERROR)].store(options.error, std::memory_order_relaxed);
+    m_backpressure[level_index(LogLevel::WARNING)].store(options.warning, std::memory_order_relaxed);
+    m_backpressure[level_index(LogLevel::INFO)].store(options.info, std::memory_order_relaxed);
+    m_backpressure[level_index(LogLevel::DEBUG)].store(options.debug, std::memory_order_relaxed);
+    m_spin_nanoseconds.store(std::chrono::duration_cast<std::chrono::nanoseconds>(options.spin).count(), std::memory_order_relaxed);
+    m_report_milliseconds.store(options.report_interval.count(), std::memory_order_relaxed);
+    //--------------------------
+} // end void Logger::Logger::set_backpressure(const BackpressureOptions& options)
+//--------------------------------------------------------------
+uint64_t Logger::Logger::dropped(const LogLevel& level) const {
+    return m_dropped[level_index(level)].load(std::memory_order_relaxed);
+} // end uint64_t Logger::Logger::dropped(const LogLevel& level) const
+//--------------------------------------------------------------
+void Logger::Logger::set_metrics(const MetricsOptions& options) {
+    //--------------------------
+    std::lock_guard<std::mutex> lock(m_mutex);
+    //--------------------------
+    m_metrics_file          = options.prometheus_file;
+    m_metrics_interval      = options.dump_interval;
+    m_next_metrics_dump     = std::chrono::steady_clock::now() + options.dump_interval;
+    m_metrics_enabled.store(options.enabled, std::memory_order_relaxed);
+    //--------------------------
+} // end void Logger::Logger::set_metrics(const MetricsOptions& options)
+//--------------------------------------------------------------
+Logger::MetricsSnapshot Logger::Logger::metrics(void) {
+    //--------------------------
+    MetricsSnapshot _snapshot;
+    //--------------------------
+    std::lock_guard<std::mutex> lock(m_mutex);
+    collect_metrics(_snapshot);
+    //--------------------------
+    return _snapshot;
+    //--------------------------
+} // end Logger::MetricsSnapshot Logger::Logger::metrics(void)
+//--------------------------------------------------------------
+void Logger::Logger::set_flight_recorder(const FlightRecorderOptions& options) {
+    //--------------------------
+    m_flight_capacity.store(options.capacity, std::memory_order_relaxed);
+    m_flight_dump_records.store(options.dump_records, std::memory_order_relaxed);
+    m_flight_scope.store(options.error_scope, std::memory_order_relaxed);
+    m_flight_on_error.store(options.levels && options.dump_on_error, std::memory_order_relaxed);
+    m_flight_levels.store(options.levels, std::memory_order_relaxed);
+    //--------------------------
+} // end void Logger::Logger::set_flight_recorder(const FlightRecorderOptions& options)
+//--------------------------------------------------------------
+void Logger::Logger::dump_flight_recorder(const FlightScope& scope, const LogLevel& route) {
+    //--------------------------
+    std::lock_guard<std::mutex> lock(m_mutex);
+    dump_flight(scope, route);
+    //--------------------------
+} // end void Logger::Logger::dump_flight_recorder(const FlightScope& scope, const LogLevel& route)
+//--------------------------------------------------------------
+void Logger::Logger::set_tracing(const TraceOptions& options) {
+    //--------------------------
+    m_trace_capacity.store(options.capacity, std::memory_order_relaxed);
+    m_trace_threshold_nanoseconds.store(std::chrono::duration_cast<std::chrono::nanoseconds>(options.slow_threshold).count(),
+                                        std::memory_order_relaxed);
+    //--------------------------
+    uint8_t _mask = options.events ? TRACE_EVENTS : 0U;
+    if (options.slow_threshold.count() > 0) {
+        _mask |= TRACE_SLOW;
+    } // end if (options.slow_threshold.count() > 0)
+    s_trace_mask.store(_mask, std::memory_order_relaxed);
+    //--------------------------
+} // end void Logger::Logger::set_tracing(const TraceOptions& options)
+//--------------------------------------------------------------
+void Logger::Logger::trace_mark(const char* name, const TracePhase& phase) {
+    //--------------------------
+    if (s_trace_mask.load(std::memory_order_relaxed) & TRACE_EVENTS) {
+        push_trace(TraceEvent{name, clock_now(), std::chrono::nanoseconds(0), thread_id(), phase});
+    } // end if (s_trace_mask.load(std::memory_order_relaxed) & TRACE_EVENTS)
+    //--------------------------
+} // end void Logger::Logger::trace_mark(const char* name, const TracePhase& phase)
+//--------------------------------------------------------------
+void Logger::Logger::trace_scope(const char* name, const std::chrono::system_clock::time_point& begin, const std::source_location& location) {
+    //--------------------------
+    const std::chrono::nanoseconds _duration = std::max(std::chrono::duration_cast<std::chrono::nanoseconds>(clock_now() - begin),
+                                                        std::chrono::nanoseconds(0));
+    const uint8_t _mask = s_trace_mask.load(std::memory_order_relaxed);
+    //--------------------------
+    if (_mask & TRACE_EVENTS) {
+        push_trace(TraceEvent{name, begin, _duration, thread_id(), TracePhase::COMPLETE});
+    } // end if (_mask & TRACE_EVENTS)
+    //--------------------------
+    // A slow scope pays for formatting, the others do not
+    if ((_mask & TRACE_SLOW) && _duration.count() >= m_trace_threshold_nanoseconds.load(std::memory_order_relaxed) &&
+        is_enabled(LogLevel::WARNING)) {
+        log(LogLevel::WARNING, FormatString("Scope {} took {} us", true, location), name, _duration.count() / 1000L);
+    } // end if ((_mask & TRACE_SLOW) && ...)
+    //--------------------------
+} // end void Logger::Logger::trace_scope(...)
+//--------------------------------------------------------------
+void Logger::Logger::set_container_limits(const ContainerLimits& limits) {
+    s_max_elements.store(limits.max_elements, std::memory_order_relaxed);
+    s_max_bytes.store(limits.max_bytes, std::memory_order_relaxed);
+} // end void Logger::Logger::set_container_limits(const ContainerLimits& limits)
+//--------------------------------------------------------------
+void Logger::Logger::add_sink(std::shared_ptr<Sink> sink, const SinkOptions& options) {
+    //--------------------------
+    if (!sink) {
+        return;
+    } // end if (!sink)
+    //--------------------------
+    std::lock_guard<std::mutex> lock(m_mutex);
+    //--------------------------
+    SinkMetrics _metrics;
+    _metrics.name = options.name.empty() ? "sink" + std::to_string(++m_sink_sequence) : options.name;
+    sink->set_batching(m_running.load(std::memory_order_acquire));
+    m_sinks.push_back(SinkEntry{std::move(sink), options.levels, formatter_slot(options.formatter), std::move(_metrics)});
+    //--------------------------
+} // end void Logger::Logger::add_sink(std::shared_ptr<Sink> sink, const SinkOptions& options)
+//--------------------------------------------------------------
+void Logger::Logger::remove_sink(const std::shared_ptr<Sink>& sink) {
+    //--------------------------
+    std::lock_guard<std::mutex> lock(m_mutex);
+    //--------------------------
+    if (std::erase_if(m_sinks, [&sink](const SinkEntry& entry) { return entry.sink == sink; }) && sink) {
+        sink->set_batching(false);
+        sink->flush();
+        compact_formatters();
+    } // end if (std::erase_if(m_sinks, ...) && sink)
+    //--------------------------
+} // end void Logger::Logger::remove_sink(const std::shared_ptr<Sink>& sink)
+//--------------------------------------------------------------
+bool Logger::Logger::set_sink_options(const std::shared_ptr<Sink>& sink, const SinkOptions& options) {
+    //--------------------------
+    std::lock_guard<std::mutex> lock(m_mutex);
+    //--------------------------
+    auto _entry = std::find_if(m_sinks.begin(), m_sinks.end(), [&sink](const SinkEntry& entry) { return entry.sink == sink; });
+    if (_entry == m_sinks.end()) {
+        return false;
+    } // end if (_entry == m_sinks.end())
+    //--------------------------
+    _entry->levels      = options.levels;
+    _entry->formatter   = formatter_slot(options.formatter);
+    compact_formatters();
+    //--------------------------
+    if (!options.name.empty()) {
+        _entry->metrics.name = options.name;
+    } // end if (!options.name.empty())
+    //--------------------------
+    return true;
+    //--------------------------
+} // end bool Logger::Logger::set_sink_options(const std::shared_ptr<Sink>& sink, const SinkOptions& options)
+//--------------------------------------------------------------
+std::shared_ptr<Logger::ConsoleSink> Logger::Logger::console_sink(void) const {
+    return m_console;
+} // end std::shared_ptr<Logger::ConsoleSink> Logger::Logger::console_sink(void) const
+//--------------------------------------------------------------
+std::shared_ptr<Logger::FileSink> Logger::Logger::error_file_sink(void) const {
+    return m_error_file;
+} // end std::shared_ptr<Logger::FileSink> Logger::Logger::error_file_sink(void) const
+//--------------------------------------------------------------
+std::shared_ptr<Logger::FileSink> Logger::Logger::warning_file_sink(void) const {
+    return m_warning_file;
+} // end std::shared_ptr<Logger::FileSink> Logger::Logger::warning_file_sink(void) const
+//--------------------------------------------------------------
+size_t Logger::Logger::formatter_slot(const std::shared_ptr<Formatter>& formatter) {
+    //--------------------------
+    if (!formatter) {
+        return 0UL;
+    } // end if (!formatter)
+    //--------------------------
+    for (size_t i = 0; i < m_formatters.size(); ++i) {
+        if (m_formatters[i].formatter == formatter) {
+            return i;
+        } // end if (m_formatters[i].formatter == formatter)
+    } // end for (size_t i = 0; i < m_formatters.size(); ++i)
+    //--------------------------
+    m_formatters.push_back(FormatterSlot{formatter, std::string(), false});
+    //--------------------------
+    return m_formatters.size() - 1UL;
+    //--------------------------
+} // end size_t Logger::Logger::formatter_slot(const std::shared_ptr<Formatter>& formatter)
+//--------------------------------------------------------------
+void Logger::Logger::compact_formatters(void) {
+    //--------------------------
+    std::vector<size_t> _slots(m_formatters.size(), SIZE_MAX);
+    _slots[0] = 0UL;
+    //--------------------------
+    std::vector<FormatterSlot> _formatters;
+    _formatters.push_back(std::move(m_formatters[0]));
+    //--------------------------
+    for (SinkEntry& _entry : m_sinks) {
+        if (_slots[_entry.formatter] == SIZE_MAX) {
+            _slots[_entry.formatter] = _formatters.size();
+            _formatters.push_back(std::move(m_formatters[_entry.formatter]));
+        } // end if (_slots[_entry.formatter] == SIZE_MAX)
+        _entry.formatter = _slots[_entry.formatter];
+    } // end for (SinkEntry& _entry : m_sinks)
+    //--------------------------
+    m_formatters = std::move(_formatters);
+    //--------------------------
+} // end void Logger::Logger::compact_formatters(void)
+//--------------------------------------------------------------
+void Logger::Logger::set_batching(const bool& enabled) {
+    //--------------------------
+    // The console stays with the logger even when it is removed from the sinks
+    m_console->set_batching(enabled);
+    for (SinkEntry& _entry : m_sinks) {
+        if (_entry.sink != m_console) {
+            _entry.sink->set_batching(enabled);
+        } // end if (_entry.sink != m_console)
+    } // end for (SinkEntry& _entry : m_sinks)
+    //--------------------------
+} // end void Logger::Logger::set_batching(const bool& enabled)
+//--------------------------------------------------------------
+void Logger::Logger::flush_files(void) {
+    //--------------------------
+    flush_repeats();
+    report_drops();
+    drain_traces();
+    //--------------------------
+    // A removed console can still hold lines written before its removal
+    m_console->flush();
+    const bool _metered = m_metrics_enabled.load(std::memory_order_relaxed);
+    for (SinkEntry& _entry : m_sinks) {
+        const auto _start = _metered ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+        _entry.sink->flush();
+        if (_metered) {
+            _entry.metrics.flush_nanoseconds += nanoseconds_since(_start);
+            ++_entry.metrics.flushes;
+        } // end if (_metered)
+    } // end for (SinkEntry& _entry : m_sinks)
+    //--------------------------
+} // end void Logger::Logger::flush_files(void)
+//--------------------------------------------------------------
+void Logger::Logger::submit(const LogLevel& level, const std::chrono::system_clock::time_point& time, std::string_view message,
+                            const std::source_location& location, const KeyValueSite* site, std::string_view fields) {
+    //--------------------------
+    if (LOGGER_UNLIKELY(is_recorded(level))) {
+        record(level, time, message, location, site, fields);
+        return;
+    } // end if (LOGGER_UNLIKELY(is_recorded(level)))
+    //--------------------------
+    const bool _metered = m_metrics_enabled.load(std::memory_order_relaxed);
+    const bool _dump    = level == LogLevel::ERROR && m_flight_on_error.load(std::memory_order_relaxed);
+    //--------------------------
+    // Both paths copy into storage whose capacity is kept from record to record
+    ThreadQueue* _queue = m_async.load(std::memory_order_acquire) ? enter_queue() : nullptr;
+    if (_queue) {
+        //--------------------------
+        if (LogRecord* _record = claim(*_queue, level)) {
+            //--------------------------
+            mark_flight(*_record, _dump);
+            _record->level  = level;
+            _record->time   = time;
+            _record->format = std::string_view();
+            _record->file   = location.file_name();
+            _record->line   = location.line();
+            _record->thread = thread_id();
+            _record->site   = site;
+            _record->message.assign(message);
+            _record->fields.assign(fields);
+            //--------------------------
+            publish(*_queue);
+            //--------------------------
+        } // end if (LogRecord* _record = claim(*_queue, level))
+        leave_queue(*_queue);
+        //--------------------------
+    } else {
+        //--------------------------
+        std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+        lock_metered(lock);
+        //--------------------------
+        if (LOGGER_UNLIKELY(_dump)) {
+            dump_flight(m_flight_scope.load(std::memory_order_relaxed), LogLevel::ERROR);
+        } // end if (LOGGER_UNLIKELY(_dump))
+        //--------------------------
+        m_record.level  = level;
+        m_record.time   = time;
+        m_record.format = std::string_view();
+        m_record.file   = location.file_name();
+        m_record.line   = location.line();
+        m_record.thread = thread_id();
+        m_record.site   = site;
+        m_record.message.assign(message);
+        m_record.fields.assign(fields);
+        //--------------------------
+        dispatch(m_record);
+        ScratchBuffer::release(m_record.message);
+        ScratchBuffer::release(m_record.fields);
+        //--------------------------
+        // Without a writer thread the periodic dump rides on the callers
+        if (LOGGER_UNLIKELY(_metered)) {
+            dump_metrics();
+        } // end if (LOGGER_UNLIKELY(_metered))
+        //--------------------------
+    } // end if (_queue)
+    //--------------------------
+    if (LOGGER_UNLIKELY(_metered)) {
+        meter_call(level, time);
+    } // end if (LOGGER_UNLIKELY(_metered))
+    //--------------------------
+} // end void Logger::Logger::submit(...)
+//--------------------------------------------------------------
+void Logger::Logger::submit_deferred(const LogLevel& level, const std::chrono::system_clock::time_point& time, const FormatString& format,
+                                     const CapturedArguments& arguments) {
+    //--------------------------
+    // Asynchronous mode stopped since log() checked it
+    ThreadQueue* _queue = enter_queue();
+    if (LOGGER_UNLIKELY(!_queue)) {
+        ScratchBuffer _message;
+        render_to(_message.text(), format.view(), arguments.data.data(), arguments.size);
+        submit(level, time, _message.text(), format.location());
+        return;
+    } // end if (LOGGER_UNLIKELY(!_queue))
+    //--------------------------
+    if (LogRecord* _record = claim(*_queue, level)) {
+        //--------------------------
+        mark_flight(*_record, level == LogLevel::ERROR && m_flight_on_error.load(std::memory_order_relaxed));
+        _record->level      = level;
+        _record->time       = time;
+        _record->format     = format.view();
+        _record->arguments  = arguments;
+        _record->file       = format.location().file_name();
+        _record->line       = format.location().line();
+        _record->thread     = thread_id();
+        _record->site       = nullptr;
+        _record->message.clear();
+        _record->fields.clear();
+        //--------------------------
+        publish(*_queue);
+        //--------------------------
+    } // end if (LogRecord* _record = claim(*_queue, level))
+    leave_queue(*_queue);
+    //--------------------------
+    if (LOGGER_UNLIKELY(m_metrics_enabled.load(std::memory_order_relaxed))) {
+        meter_call(level, time);
+    } // end if (LOGGER_UNLIKELY(m_metrics_enabled.load(std::memory_order_relaxed)))
+    //--------------------------
+} // end void Logger::Logger::submit_deferred(...)
+//--------------------------------------------------------------
+void Logger::Logger::record(const LogLevel& level, const std::chrono::system_clock::time_point& time, std::string_view message,
+                            const std::source_location& location, const KeyValueSite* site, std::string_view fields) {
+    //--------------------------
+    FlightRecorder& _recorder = local_recorder();
+    {
+        std::lock_guard<std::mutex> lock(_recorder.mutex());
+        //--------------------------
+        LogRecord& _record = _recorder.next();
+        _record.level   = level;
+        _record.time    = time;
+        _record.format  = std::string_view();
+        _record.file    = location.file_name();
+        _record.line    = location.line();
+        _record.thread  = _recorder.thread();
+        _record.site    = site;
+        _record.message.assign(message);
+        _record.fields.assign(fields);
+    }
+    //--------------------------
+    if (LOGGER_UNLIKELY(m_metrics_enabled.load(std::memory_order_relaxed))) {
+        meter_call(level, time);
+    } // end if (LOGGER_UNLIKELY(m_metrics_enabled.load(std::memory_order_relaxed)))
+    //--------------------------
+} // end void Logger::Logger::record(...)
+//--------------------------------------------------------------
+void Logger::Logger::record_deferred(const LogLevel& level, const std::chrono::system_clock::time_point& time, const FormatString& format,
+                                     const CapturedArguments& arguments) {
+    //--------------------------
+    FlightRecorder& _recorder = local_recorder();
+    {
+        std::lock_guard<std::mutex> lock(_recorder.mutex());
+        //--------------------------
+        LogRecord& _record = _recorder.next();
+        _record.level       = level;
+        _record.time        = time;
+        _record.file        = format.location().file_name();
+        _record.line        = format.location().line();
+        _record.thread      = _recorder.thread();
+        _record.site        = nullptr;
+        _record.message.clear();
+        _record.fields.clear();
+        //--------------------------
+        // The slot outlives the call and is read by the crash handler; log() only defers literals
+        _record.format      = format.view();
+        _record.arguments   = arguments;
+    }
+    //--------------------------
+    if (LOGGER_UNLIKELY(m_metrics_enabled.load(std::memory_order_relaxed))) {
+        meter_call(level, time);
+    } // end if (LOGGER_UNLIKELY(m_metrics_enabled.load(std::memory_order_relaxed)))
+    //--------------------------
+} // end void Logger::Logger::record_deferred(...)
+//--------------------------------------------------------------
+Logger::LogRecord* Logger::Logger::claim(ThreadQueue& queue, const LogLevel& level) {
+    //--------------------------
+    LogRecord* _record = queue.queue.claim();
+    if (LOGGER_LIKELY(_record != nullptr)) {
+        return _record;
+    } // end if (LOGGER_LIKELY(_record != nullptr))
+    //--------------------------
+    wake_writer();
+    //--------------------------
+    switch (m_backpressure[level_index(level)].load(std::memory_order_relaxed)) {
+        case Backpressure::BLOCK:
+            while (!(_record = queue.queue.claim())) {
+                wake_writer();
+                std::this_thread::yield();
+            } // end while (!(_record = queue.queue.claim()))
+            return _record;
+        case Backpressure::SPIN_THEN_DROP: {
+            const auto _deadline = std::chrono::steady_clock::now() +
+                                   std::chrono::nanoseconds(m_spin_nanoseconds.load(std::memory_order_relaxed));
+            do {
+                std::this_thread::yield();
+                if ((_record = queue.queue.claim())) {
+                    return _record;
+                } // end if ((_record = queue.queue.claim()))
+            } while (std::chrono::steady_clock::now() < _deadline);
             break;
-        case LogLevel::ERROR:
-#if __cpp_lib_format
-            std::print(ANSI_COLOR_RED "{}" ANSI_COLOR_RESET "\n", message);
-#else
-            fmt::print(fmt::fg(fmt::color::red), "{}\n", message);
-#endif
-            log_file("error_log.txt", message);
+        }
+        case Backpressure::OVERWRITE_OLDEST:
+            // Never at the expense of a level that must not be dropped
+            _record = queue.queue.evict([this](const LogRecord& oldest) {
+                return m_backpressure[level_index(oldest.level)].load(std::memory_order_relaxed) != Backpressure::BLOCK;
+            });
+            if (_record) {
+                m_dropped[level_index(_record->level)].fetch_add(1UL, std::memory_order_relaxed);
+                return _record;
+            } // end if (_record)
             break;
-        case LogLevel::WARNING:
-#if __cpp_lib_format
-            std::print(ANSI_COLOR_YELLOW "{}" ANSI_COLOR_RESET "\n", message);
+        case Backpressure::DROP_NEWEST:
+            break;
+    } // end switch (m_backpressure[level_index(level)].load(std::memory_order_relaxed))
+    //--------------------------
+    m_dropped[level_index(level)].fetch_add(1UL, std::memory_order_relaxed);
+    //--------------------------
+    return nullptr;
+    //--------------------------
+} // end Logger::LogRecord* Logger::Logger::claim(ThreadQueue& queue, const LogLevel& level)
+//--------------------------------------------------------------
+Logger::ThreadQueue* Logger::Logger::enter_queue(void) {
+    //--------------------------
+    // Pairs with stop_async(): either this load sees the mode cleared, or stop_async() sees the flag and waits
+    ThreadQueue& _queue = local_queue();
+    _queue.producing.store(true, std::memory_order_seq_cst);
+    if (LOGGER_LIKELY(m_async.load(std::memory_order_seq_cst))) {
+        return &_queue;
+    } // end if (LOGGER_LIKELY(m_async.load(std::memory_order_seq_cst)))
+    //--------------------------
+    leave_queue(_queue);
+    return nullptr;
+    //--------------------------
+} // end Logger::ThreadQueue* Logger::Logger::enter_queue(void)
+//--------------------------------------------------------------
+void Logger::Logger::mark_flight(LogRecord& record, const bool& dump) {
+    //--------------------------
+    record.flight_dump = dump;
+    //--------------------------
+    // A slot taken over by OVERWRITE_OLDEST may still hold the recorder of a dump it never got
+    if (LOGGER_UNLIKELY(dump || record.flight)) {
+        record.flight       = dump ? t_recorder.recorder : nullptr;
+        record.flight_end   = record.flight ? record.flight->end() : 0UL;
+    } // end if (LOGGER_UNLIKELY(dump || record.flight))
+    //--------------------------
+} // end void Logger::Logger::mark_flight(LogRecord& record, const bool& dump)
+//--------------------------------------------------------------
+void Logger::Logger::publish(ThreadQueue& queue) {
+    //--------------------------
+    queue.queue.publish();
+    //--------------------------
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_writer_idle.load(std::memory_order_relaxed)) {
+        wake_writer();
+    } // end if (m_writer_idle.load(std::memory_order_relaxed))
+    //--------------------------
+} // end void Logger::Logger::publish(ThreadQueue& queue)
+//--------------------------------------------------------------
+uint64_t Logger::Logger::thread_id(void) {
+    //--------------------------
+    thread_local const uint64_t t_id = [] {
+#if defined(__linux__)
+        return static_cast<uint64_t>(syscall(SYS_gettid));
 #else
-            fmt::print(fmt::fg(fmt::color::yellow), "{}\n", message);
+        return static_cast<uint64_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
 #endif
-            log_file("warning_log.txt", message);
+    }();
+    //--------------------------
+    return t_id;
+    //--------------------------
+} // end uint64_t Logger::Logger::thread_id(void)
+//--------------------------------------------------------------
+Logger::ThreadQueue& Logger::Logger::local_queue(void) {
+    //--------------------------
+    if (LOGGER_LIKELY(t_queue.queue != nullptr)) {
+        return *t_queue.queue;
+    } // end if (LOGGER_LIKELY(t_queue.queue != nullptr))
+    //--------------------------
+    t_queue.queue = std::make_shared<ThreadQueue>(m_queue_capacity.load(std::memory_order_relaxed));
+    //--------------------------
+    {
+        std::lock_guard<std::mutex> lock(m_queues_mutex);
+        m_queues.push_back(t_queue.queue);
+        m_queues_version.fetch_add(1UL, std::memory_order_seq_cst);
+    }
+    //--------------------------
+    return *t_queue.queue;
+    //--------------------------
+} // end Logger::ThreadQueue& Logger::Logger::local_queue(void)
+//--------------------------------------------------------------
+Logger::MetricsShard& Logger::Logger::local_shard(void) {
+    //--------------------------
+    if (LOGGER_LIKELY(t_shard.shard != nullptr)) {
+        return *t_shard.shard;
+    } // end if (LOGGER_LIKELY(t_shard.shard != nullptr))
+    //--------------------------
+    t_shard.shard = std::make_shared<MetricsShard>();
+    //--------------------------
+    {
+        std::lock_guard<std::mutex> lock(m_shards_mutex);
+        m_shards.push_back(t_shard.shard);
+    }
+    //--------------------------
+    return *t_shard.shard;
+    //--------------------------
+} // end Logger::MetricsShard& Logger::Logger::local_shard(void)
+//--------------------------------------------------------------
+Logger::TraceQueue& Logger::Logger::local_trace_queue(void) {
+    //--------------------------
+    if (LOGGER_LIKELY(t_trace_queue.queue != nullptr)) {
+        return *t_trace_queue.queue;
+    } // end if (LOGGER_LIKELY(t_trace_queue.queue != nullptr))
+    //--------------------------
+    t_trace_queue.queue = std::make_shared<TraceQueue>(m_trace_capacity.load(std::memory_order_relaxed));
+    //--------------------------
+    {
+        std::lock_guard<std::mutex> lock(m_trace_queues_mutex);
+        m_trace_queues.push_back(t_trace_queue.queue);
+    }
+    //--------------------------
+    return *t_trace_queue.queue;
+    //--------------------------
+} // end Logger::TraceQueue& Logger::Logger::local_trace_queue(void)
+//--------------------------------------------------------------
+void Logger::Logger::push_trace(const TraceEvent& event) {
+    //--------------------------
+    TraceQueue& _queue = local_trace_queue();
+    TraceEvent* _slot = _queue.queue.claim();
+    //--------------------------
+    // Nothing waits on the writer: the owner frees its own buffer, after which the claim cannot fail
+    if (LOGGER_UNLIKELY(_slot == nullptr)) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        drain_traces();
+        _slot = _queue.queue.claim();
+    } // end if (LOGGER_UNLIKELY(_slot == nullptr))
+    //--------------------------
+    *_slot = event;
+    _queue.queue.publish();
+    //--------------------------
+} // end void Logger::Logger::push_trace(const TraceEvent& event)
+//--------------------------------------------------------------
+Logger::FlightRecorder& Logger::Logger::local_recorder(void) {
+    //--------------------------
+    if (LOGGER_LIKELY(t_recorder.recorder != nullptr)) {
+        return *t_recorder.recorder;
+    } // end if (LOGGER_LIKELY(t_recorder.recorder != nullptr))
+    //--------------------------
+    t_recorder.recorder = std::make_shared<FlightRecorder>(m_flight_capacity.load(std::memory_order_relaxed), thread_id());
+    //--------------------------
+    {
+        std::lock_guard<std::mutex> lock(m_recorders_mutex);
+        // Exited threads are dropped here so that churning threads do not pile up rings
+        std::erase_if(m_recorders, [](const auto& recorder) { return recorder->closed.load(std::memory_order_acquire); });
+        m_recorders.push_back(t_recorder.recorder);
+    }
+    //--------------------------
+    return *t_recorder.recorder;
+    //--------------------------
+} // end Logger::FlightRecorder& Logger::Logger::local_recorder(void)
+//--------------------------------------------------------------
+void Logger::Logger::lock_metered(std::unique_lock<std::mutex>& lock) {
+    //--------------------------
+    // An uncontended lock costs no clock reads
+    if (!m_metrics_enabled.load(std::memory_order_relaxed) || lock.try_lock()) {
+        if (!lock.owns_lock()) {
+            lock.lock();
+        } // end if (!lock.owns_lock())
+        return;
+    } // end if (!m_metrics_enabled.load(std::memory_order_relaxed) || lock.try_lock())
+    //--------------------------
+    const auto _start = std::chrono::steady_clock::now();
+    lock.lock();
+    const uint64_t _waited = nanoseconds_since(_start);
+    //--------------------------
+    MetricsShard& _shard = local_shard();
+    MetricsShard::add(_shard.lock_waits, 1UL);
+    MetricsShard::add(_shard.lock_wait_nanoseconds, _waited);
+    //--------------------------
+} // end void Logger::Logger::lock_metered(std::unique_lock<std::mutex>& lock)
+//--------------------------------------------------------------
+void Logger::Logger::meter_call(const LogLevel& level, const std::chrono::system_clock::time_point& time) {
+    //--------------------------
+    const auto _elapsed = clock_now() - time;
+    const uint64_t _nanoseconds = _elapsed.count() > 0 ?
+        static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(_elapsed).count()) : 0UL;
+    //--------------------------
+    MetricsShard& _shard = local_shard();
+    MetricsShard::add(_shard.messages[level_index(level)], 1UL);
+    MetricsShard::add(_shard.latency[latency_bucket(_nanoseconds)], 1UL);
+    MetricsShard::add(_shard.latency_nanoseconds, _nanoseconds);
+    //--------------------------
+} // end void Logger::Logger::meter_call(const LogLevel& level, const std::chrono::system_clock::time_point& time)
+//--------------------------------------------------------------
+void Logger::Logger::wake_writer(void) {
+    //--------------------------
+    {
+        std::lock_guard<std::mutex> lock(m_writer_mutex);
+        m_writer_idle.store(false, std::memory_order_relaxed);
+    }
+    m_writer_cv.notify_one();
+    //--------------------------
+} // end void Logger::Logger::wake_writer(void)
+//--------------------------------------------------------------
+void Logger::Logger::writer_loop(void) {
+    //--------------------------
+    constexpr auto IDLE_TIMEOUT = std::chrono::milliseconds(10);
+    //--------------------------
+    while (true) {
+        //--------------------------
+        const bool _running     = m_running.load(std::memory_order_acquire);
+        const uint64_t _flush   = m_flush_requested.load(std::memory_order_acquire);
+        const size_t _written   = drain_queue();
+        //--------------------------
+        // Reported during a burst too, that is when records are dropped
+        const int64_t _report = m_report_milliseconds.load(std::memory_order_relaxed);
+        if (_report > 0) {
+            const auto _now = std::chrono::steady_clock::now();
+            if (_now >= m_next_drop_report) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                report_drops();
+                m_next_drop_report = _now + std::chrono::milliseconds(_report);
+            } // end if (_now >= m_next_drop_report)
+        } // end if (_report > 0)
+        //--------------------------
+        if (LOGGER_UNLIKELY(m_metrics_enabled.load(std::memory_order_relaxed))) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            dump_metrics();
+        } // end if (LOGGER_UNLIKELY(m_metrics_enabled.load(std::memory_order_relaxed)))
+        //--------------------------
+        if (LOGGER_UNLIKELY(s_trace_mask.load(std::memory_order_relaxed) & TRACE_EVENTS)) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            drain_traces();
+        } // end if (LOGGER_UNLIKELY(s_trace_mask.load(std::memory_order_relaxed) & TRACE_EVENTS))
+        //--------------------------
+        if (_flush != m_flush_completed.load(std::memory_order_relaxed)) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                flush_files();
+            }
+            {
+                std::lock_guard<std::mutex> lock(m_flush_mutex);
+                m_flush_completed.store(_flush, std::memory_order_release);
+            }
+            m_flush_cv.notify_all();
+        } // end if (_flush != m_flush_completed.load(std::memory_order_relaxed))
+        //--------------------------
+        if (!_running) {
             break;
-        case LogLevel::INFO:
+        } // end if (!_running)
+        //--------------------------
+        if (_written) {
+            continue;
+        } // end if (_written)
+        //--------------------------
+        {
+            const auto _now = std::chrono::steady_clock::now();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            //--------------------------
+            // A run that has ended is reported once its window has passed
+            if (m_repeats && std::chrono::system_clock::now() - m_last_repeat >= m_dedup_window) {
+                flush_repeats();
+            } // end if (m_repeats && ...)
+            //--------------------------
+            // Every sink commits on its own schedule, the console at the end of the writer's batch
+            m_console->flush();
+            for (const SinkEntry& _entry : m_sinks) {
+                _entry.sink->poll(_now);
+            } // end for (const SinkEntry& _entry : m_sinks)
+        }
+        //--------------------------
+        // Publish the idle flag before the final emptiness check so producers cannot miss us
+        m_writer_idle.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        //--------------------------
+        const bool _empty = m_queues_version.load(std::memory_order_acquire) == m_drain_version &&
+                            std::all_of(m_drain_queues.begin(), m_drain_queues.end(),
+                                        [](const auto& queue) { return queue->queue.empty(); });
+        //--------------------------
+        if (_empty && m_running.load(std::memory_order_acquire) &&
+            m_flush_requested.load(std::memory_order_acquire) == m_flush_completed.load(std::memory_order_relaxed)) {
+            std::unique_lock<std::mutex> lock(m_writer_mutex);
+            m_writer_cv.wait_for(lock, IDLE_TIMEOUT, [this] { return !m_writer_idle.load(std::memory_order_relaxed); });
+        } // end if (_empty && ...)
+        //--------------------------
+        m_writer_idle.store(false, std::memory_order_relaxed);
+        //--------------------------
+    } // end while (true)
+    //--------------------------
+    {
+        std::lock_guard<std::mutex> lock(m_flush_mutex);
+        m_flush_completed.store(m_flush_requested.load(std::memory_order_acquire), std::memory_order_release);
+    }
+    m_flush_cv.notify_all();
+    //--------------------------
+} // end void Logger::Logger::writer_loop(void)
+//--------------------------------------------------------------
+size_t Logger::Logger::drain_queue(void) {
+    //--------------------------
+    if (m_queues_version.load(std::memory_order_acquire) != m_drain_version) {
+        std::lock_guard<std::mutex> lock(m_queues_mutex);
+        m_drain_queues  = m_queues;
+        m_drain_version = m_queues_version.load(std::memory_order_relaxed);
+    } // end if (m_queues_version.load(std::memory_order_acquire) != m_drain_version)
+    //--------------------------
+    // Closed rings are checked before draining so nothing can be pushed after the last pop
+    bool _closed = false;
+    for (const auto& _queue : m_drain_queues) {
+        _closed |= _queue->closed.load(std::memory_order_acquire);
+    } // end for (const auto& _queue : m_drain_queues)
+    //--------------------------
+    // K-way merge of the rings by timestamp; a ring is re-examined only after one of its records is written
+    const auto _later = [](const auto& left, const auto& right) { return left.first > right.first; };
+    //--------------------------
+    m_drain_heap.clear();
+    for (size_t i = 0; i < m_drain_queues.size(); ++i) {
+        m_drain_queues[i]->drained = 0UL;
+        if (const LogRecord* _record = m_drain_queues[i]->queue.front()) {
+            m_drain_heap.emplace_back(_record->time, i);
+        } // end if (const LogRecord* _record = m_drain_queues[i]->queue.front())
+    } // end for (size_t i = 0; i < m_drain_queues.size(); ++i)
+    std::make_heap(m_drain_heap.begin(), m_drain_heap.end(), _later);
+    //--------------------------
+    size_t _count = 0UL;
+    //--------------------------
+    if (!m_drain_heap.empty()) {
+        //--------------------------
+        std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+        lock_metered(lock);
+        //--------------------------
+        while (!m_drain_heap.empty()) {
+            //--------------------------
+            std::pop_heap(m_drain_heap.begin(), m_drain_heap.end(), _later);
+            ThreadQueue& _thread_queue = *m_drain_queues[m_drain_heap.back().second];
+            SPSCQueue<LogRecord>& _queue = _thread_queue.queue;
+            //--------------------------
+            // The producer may have overwritten the record since it was peeked
+            if (LogRecord* _front = _queue.take()) {
+                if (LOGGER_UNLIKELY(_front->flight_dump)) {
+                    dump_flight(*_front);
+                    _front->flight.reset();
+                } // end if (LOGGER_UNLIKELY(_front->flight_dump))
+                dispatch(*_front);
+                ScratchBuffer::release(_front->message);
+                ScratchBuffer::release(_front->fields);
+                _queue.pop();
+                ++_thread_queue.drained;
+                ++_count;
+            } // end if (LogRecord* _front = _queue.take())
+            //--------------------------
+            if (const LogRecord* _record = _queue.front()) {
+                m_drain_heap.back().first = _record->time;
+                std::push_heap(m_drain_heap.begin(), m_drain_heap.end(), _later);
+            } else {
+                m_drain_heap.pop_back();
+            } // end if (const LogRecord* _record = _queue.front())
+            //--------------------------
+        } // end while (!m_drain_heap.empty())
+        //--------------------------
+        // Records that arrived during the pass are counted too, hence the cap
+        if (LOGGER_UNLIKELY(m_metrics_enabled.load(std::memory_order_relaxed))) {
+            for (const auto& _queue : m_drain_queues) {
+                m_queue_high_water = std::max(m_queue_high_water, std::min(_queue->drained, _queue->queue.capacity()));
+            } // end for (const auto& _queue : m_drain_queues)
+        } // end if (LOGGER_UNLIKELY(m_metrics_enabled.load(std::memory_order_relaxed)))
+        //--------------------------
+    } // end if (!m_drain_heap.empty())
+    //--------------------------
+    if (_closed) {
+        //--------------------------
+        std::lock_guard<std::mutex> lock(m_queues_mutex);
+        //--------------------------
+        const size_t _removed = std::erase_if(m_queues, [](const auto& queue) {
+            return queue->closed.load(std::memory_order_acquire) && queue->queue.empty();
+        });
+        //--------------------------
+        if (_removed) {
+            m_queues_version.fetch_add(1UL, std::memory_order_seq_cst);
+        } // end if (_removed)
+        //--------------------------
+    } // end if (_closed)
+    //--------------------------
+    return _count;
+    //--------------------------
+} // end size_t Logger::Logger::drain_queue(void)
+//--------------------------------------------------------------
+void Logger::Logger::dispatch(LogRecord& record) {
+    //--------------------------
+    if (!record.format.empty()) {
+        record.message.clear();
+        render_to(record.message, record.format, record.arguments.data.data(), record.arguments.size);
+    } // end if (!record.format.empty())
+    //--------------------------
+    if (m_dedup_window.count() > 0 && collapse(record)) {
+        return;
+    } // end if (m_dedup_window.count() > 0 && collapse(record))
+    //--------------------------
+    write_record(record);
+    //--------------------------
+} // end void Logger::Logger::dispatch(LogRecord& record)
+//--------------------------------------------------------------
+void Logger::Logger::write_record(const LogRecord& record, const uint8_t& route) {
+    //--------------------------
+    const auto _level   = route ? route : static_cast<uint8_t>(record.level);
+    const bool _metered = m_metrics_enabled.load(std::memory_order_relaxed);
+    //--------------------------
+    if (LOGGER_UNLIKELY(_metered)) {
+        m_bytes[level_index(record.level)] += record.message.size() + record.fields.size();
+    } // end if (LOGGER_UNLIKELY(_metered))
+    //--------------------------
+    // Each formatter runs the first time a sink needs it, its output is shared with the sinks after
+    for (SinkEntry& _entry : m_sinks) {
+        //--------------------------
+        if (!(_entry.levels & _level)) {
+            continue;
+        } // end if (!(_entry.levels & _level))
+        //--------------------------
+        FormatterSlot& _slot = m_formatters[_entry.formatter];
+        if (!_slot.ready) {
+            _slot.formatter->format(record, _slot.line);
+            _slot.ready = true;
+        } // end if (!_slot.ready)
+        //--------------------------
+        if (LOGGER_UNLIKELY(_metered)) {
+            const auto _start = std::chrono::steady_clock::now();
+            _entry.sink->write(record, _slot.line);
+            _entry.metrics.write_nanoseconds += nanoseconds_since(_start);
+            ++_entry.metrics.writes;
+        } else {
+            _entry.sink->write(record, _slot.line);
+        } // end if (LOGGER_UNLIKELY(_metered))
+        //--------------------------
+    } // end for (SinkEntry& _entry : m_sinks)
+    //--------------------------
+    for (FormatterSlot& _slot : m_formatters) {
+        if (_slot.ready) {
+            ScratchBuffer::release(_slot.line);
+            _slot.ready = false;
+        } // end if (_slot.ready)
+    } // end for (FormatterSlot& _slot : m_formatters)
+    //--------------------------
+} // end void Logger::Logger::write_record(const LogRecord& record, const uint8_t& route)
+//--------------------------------------------------------------
+bool Logger::Logger::collapse(const LogRecord& record) {
+    //--------------------------
+    const size_t _hash = std::hash<std::string_view>{}(record.message) ^ std::hash<std::string_view>{}(record.fields);
+    //--------------------------
+    if (_hash == m_last_hash && record.level == m_last_level && record.message == m_last_message &&
+        record.fields == m_last_fields) {
+        //--------------------------
+        // A long run still reports once per window
+        if (m_repeats && record.time - m_first_repeat >= m_dedup_window) {
+            flush_repeats();
+        } // end if (m_repeats && record.time - m_first_repeat >= m_dedup_window)
+        //--------------------------
+        if (!m_repeats) {
+            m_first_repeat = record.time;
+        } // end if (!m_repeats)
+        //--------------------------
+        ++m_repeats;
+        m_last_repeat = record.time;
+        //--------------------------
+        return true;
+        //--------------------------
+    } // end if (_hash == m_last_hash && ...)
+    //--------------------------
+    flush_repeats();
+    //--------------------------
+    m_last_hash     = _hash;
+    m_last_level    = record.level;
+    m_last_message.assign(record.message);
+    m_last_fields.assign(record.fields);
+    //--------------------------
+    return false;
+    //--------------------------
+} // end bool Logger::Logger::collapse(const LogRecord& record)
+//--------------------------------------------------------------
+void Logger::Logger::flush_repeats(void) {
+    //--------------------------
+    if (!m_repeats) {
+        return;
+    } // end if (!m_repeats)
+    //--------------------------
+    char _first[Timestamp::MAX_LENGTH];
+    char _last[Timestamp::MAX_LENGTH];
+    const std::string_view _first_view(_first, Timestamp::format(m_first_repeat, _first));
+    const std::string_view _last_view(_last, Timestamp::format(m_last_repeat, _last));
+    //--------------------------
+    LogRecord _summary;
+    _summary.level  = m_last_level;
+    _summary.time   = m_last_repeat;
 #if __cpp_lib_format
-            std::print("{}\n", message);
+    _summary.message = std::format("Last message repeated {} times between {} and {}", m_repeats, _first_view, _last_view);
 #else
-            fmt::print("{}\n", message);
+    _summary.message = fmt::format("Last message repeated {} times between {} and {}", m_repeats, _first_view, _last_view);
 #endif
-            break;
-    } // end switch(level)
-}// end void Logger::Logger::level_message(LogLevel level, std::string_view message)
-//--------------------------------------------------------------
-constexpr std::string_view Logger::Logger::level_print(const LogLevel& level) const {
     //--------------------------
-    switch (level) {
-        case LogLevel::DEBUG:
-            return " [DEBUG]: ";
-        case LogLevel::ERROR:
-            return " [ERROR]: ";
-        case LogLevel::WARNING:
-            return " [WARNING]: ";
-        case LogLevel::INFO:
-            return " [INFO]: ";
-        default:
-            return " [UNKNOWN]: ";
-    } // end switch(level)
+    m_repeats = 0UL;
+    write_record(_summary);
     //--------------------------
-}// end std::string Logger::Logger::level_print(const LogLevel& level)
+} // end void Logger::Logger::flush_repeats(void)
 //--------------------------------------------------------------
-std::string Logger::Logger::format_message(const LogLevel& level, std::string_view message, const std::chrono::system_clock::time_point& now) const {
+void Logger::Logger::report_drops(void) {
+    //--------------------------
+    std::array<uint64_t, LEVEL_COUNT> _dropped{};
+    uint64_t _total = 0UL;
+    for (const LogLevel& _level : LEVELS) {
+        const size_t _index = level_index(_level);
+        const uint64_t _count = m_dropped[_index].load(std::memory_order_relaxed);
+        _dropped[_index] = _count - m_dropped_reported[_index];
+        m_dropped_reported[_index] = _count;
+        _total += _dropped[_index];
+    } // end for (const LogLevel& _level : LEVELS)
     //--------------------------
-    const auto localtime = std::chrono::system_clock::to_time_t(now);
-    std::ostringstream oss;
+    if (!_total) {
+        return;
+    } // end if (!_total)
     //--------------------------
+    LogRecord _summary;
+    _summary.level  = LogLevel::WARNING;
+    _summary.time   = clock_now();
 #if __cpp_lib_format
-    oss << std::format("{:%Y-%m-%d %H:%M:%S}", *std::localtime(&localtime));
+    std::format_to(std::back_inserter(_summary.message), "Dropped {} records under backpressure (", _total);
 #else
-    oss << fmt::format("{:%Y-%m-%d %H:%M:%S}", fmt::localtime(localtime));
+    fmt::format_to(std::back_inserter(_summary.message), "Dropped {} records under backpressure (", _total);
 #endif
+    bool _first = true;
+    for (const LogLevel& _level : LEVELS) {
+        if (!_dropped[level_index(_level)]) {
+            continue;
+        } // end if (!_dropped[level_index(_level)])
+        _summary.message.append(_first ? "" : ", ").append(level_name(_level)).append(": ");
+        print_element(_summary.message, _dropped[level_index(_level)]);
+        _first = false;
+    } // end for (const LogLevel& _level : LEVELS)
+    _summary.message.push_back(')');
     //--------------------------
-    oss << level_print(level);
+    write_record(_summary);
     //--------------------------
-    oss << message;
+} // end void Logger::Logger::report_drops(void)
+//--------------------------------------------------------------
+void Logger::Logger::collect_metrics(MetricsSnapshot& snapshot) {
+    //--------------------------
+    snapshot.bytes              = m_bytes;
+    snapshot.queue_high_water   = m_queue_high_water;
+    for (size_t i = 0; i < LEVEL_COUNT; ++i) {
+        snapshot.dropped[i] = m_dropped[i].load(std::memory_order_relaxed);
+    } // end for (size_t i = 0; i < LEVEL_COUNT; ++i)
+    //--------------------------
+    snapshot.sinks.reserve(m_sinks.size());
+    for (const SinkEntry& _entry : m_sinks) {
+        snapshot.sinks.push_back(_entry.metrics);
+    } // end for (const SinkEntry& _entry : m_sinks)
     //--------------------------
-    return oss.str();
+    std::lock_guard<std::mutex> lock(m_shards_mutex);
     //--------------------------
-}// end std::string Logger::Logger::format_message(const LogLevel& level, std::string_view message, const std::chrono::system_clock::time_point& now) const
+    // Threads that exited no longer write their shards, their counts move to the totals
+    std::erase_if(m_shards, [this](const auto& shard) {
+        if (!shard->closed.load(std::memory_order_acquire)) {
+            return false;
+        } // end if (!shard->closed.load(std::memory_order_acquire))
+        shard->collect(m_retired);
+        return true;
+    });
+    //--------------------------
+    snapshot.messages               = m_retired.messages;
+    snapshot.latency                = m_retired.latency;
+    snapshot.latency_nanoseconds    = m_retired.latency_nanoseconds;
+    snapshot.lock_waits             = m_retired.lock_waits;
+    snapshot.lock_wait_nanoseconds  = m_retired.lock_wait_nanoseconds;
+    for (const auto& _shard : m_shards) {
+        _shard->collect(snapshot);
+    } // end for (const auto& _shard : m_shards)
+    //--------------------------
+} // end void Logger::Logger::collect_metrics(MetricsSnapshot& snapshot)
 //--------------------------------------------------------------
-void Logger::Logger::log_file(const std::string& filename, std::string_view message) const {
+void Logger::Logger::dump_metrics(void) {
     //--------------------------
-    std::ofstream _log_file(filename, std::ios_base::app);
+    if (m_metrics_file.empty()) {
+        return;
+    } // end if (m_metrics_file.empty())
     //--------------------------
-    if (_log_file.is_open()) {
-        if (!_log_file.tellp()) { // Check if the file is empty
-            //--------------------------
-            const auto now          = std::chrono::system_clock::now();
-            const auto localtime    = std::chrono::system_clock::to_time_t(now);
-            //--------------------------
+    const auto _now = std::chrono::steady_clock::now();
+    if (_now < m_next_metrics_dump) {
+        return;
+    } // end if (_now < m_next_metrics_dump)
+    m_next_metrics_dump = _now + m_metrics_interval;
+    //--------------------------
+    MetricsSnapshot _snapshot;
+    collect_metrics(_snapshot);
+    _snapshot.write_prometheus_file(m_metrics_file);
+    //--------------------------
+} // end void Logger::Logger::dump_metrics(void)
+//--------------------------------------------------------------
+void Logger::Logger::dump_flight(const FlightScope& scope, const LogLevel& route) {
+    //--------------------------
+    // A pending repeat summary belongs before the dump
+    flush_repeats();
+    //--------------------------
+    if (scope == FlightScope::THREAD) {
+        if (t_recorder.recorder) {
+            dump_recorder(*t_recorder.recorder, route);
+        } // end if (t_recorder.recorder)
+        return;
+    } // end if (scope == FlightScope::THREAD)
+    //--------------------------
+    std::lock_guard<std::mutex> lock(m_recorders_mutex);
+    for (const auto& _recorder : m_recorders) {
+        dump_recorder(*_recorder, route);
+    } // end for (const auto& _recorder : m_recorders)
+    //--------------------------
+} // end void Logger::Logger::dump_flight(const FlightScope& scope, const LogLevel& route)
+//--------------------------------------------------------------
+void Logger::Logger::dump_flight(const LogRecord& record) {
+    //--------------------------
+    flush_repeats();
+    //--------------------------
+    // Later records of the producer stay for the next dump, they come after the ERROR
+    if (m_flight_scope.load(std::memory_order_relaxed) == FlightScope::THREAD) {
+        if (record.flight) {
+            dump_recorder(*record.flight, LogLevel::ERROR, record.flight_end);
+        } // end if (record.flight)
+        return;
+    } // end if (m_flight_scope.load(std::memory_order_relaxed) == FlightScope::THREAD)
+    //--------------------------
+    std::lock_guard<std::mutex> lock(m_recorders_mutex);
+    for (const auto& _recorder : m_recorders) {
+        dump_recorder(*_recorder, LogLevel::ERROR, _recorder == record.flight ? record.flight_end : UINT64_MAX);
+    } // end for (const auto& _recorder : m_recorders)
+    //--------------------------
+} // end void Logger::Logger::dump_flight(const LogRecord& record)
+//--------------------------------------------------------------
+void Logger::Logger::dump_recorder(FlightRecorder& recorder, const LogLevel& route, const uint64_t& last) {
+    //--------------------------
+    std::lock_guard<std::mutex> lock(recorder.mutex());
+    //--------------------------
+    const uint64_t _end     = std::min(last, recorder.end());
+    const uint64_t _begin   = recorder.begin(m_flight_dump_records.load(std::memory_order_relaxed), _end);
+    if (_begin == _end) {
+        return;
+    } // end if (_begin == _end)
+    //--------------------------
+    LogRecord _header;
+    _header.level   = route;
+    _header.time    = clock_now();
+    _header.thread  = recorder.thread();
 #if __cpp_lib_format
-            _log_file << std::format("Log file created at: {:%Y-%m-%d %H:%M:%S}\n", *std::localtime(&localtime));
+    std::format_to(std::back_inserter(_header.message), "Flight recorder: last {} records of thread {}", _end - _begin, recorder.thread());
 #else
-            _log_file << fmt::format("Log file created at: {:%Y-%m-%d %H:%M:%S}\n", fmt::localtime(localtime));
+    fmt::format_to(std::back_inserter(_header.message), "Flight recorder: last {} records of thread {}", _end - _begin, recorder.thread());
 #endif
-        } // end if (!_log_file.tellp())
+    write_record(_header);
+    //--------------------------
+    // Records keep their level in the output but go where the route level goes
+    for (uint64_t _sequence = _begin; _sequence != _end; ++_sequence) {
+        LogRecord& _record = recorder.at(_sequence);
+        if (!_record.format.empty()) {
+            _record.message.clear();
+            render_to(_record.message, _record.format, _record.arguments.data.data(), _record.arguments.size);
+            _record.format = std::string_view();
+        } // end if (!_record.format.empty())
+        write_record(_record, static_cast<uint8_t>(route));
+    } // end for (uint64_t _sequence = _begin; _sequence != _end; ++_sequence)
+    //--------------------------
+    recorder.mark_dumped(_end);
+    //--------------------------
+} // end void Logger::Logger::dump_recorder(FlightRecorder& recorder, const LogLevel& route, const uint64_t& last)
+//--------------------------------------------------------------
+void Logger::Logger::drain_traces(void) {
+    //--------------------------
+    std::lock_guard<std::mutex> lock(m_trace_queues_mutex);
+    //--------------------------
+    if (m_trace_queues.empty()) {
+        return;
+    } // end if (m_trace_queues.empty())
+    //--------------------------
+    bool _closed = false;
+    for (const auto& _queue : m_trace_queues) {
+        //--------------------------
+        _closed |= _queue->closed.load(std::memory_order_acquire);
         //--------------------------
-        _log_file << message << std::endl;
+        while (_queue->queue.front()) {
+            if (const TraceEvent* _event = _queue->queue.take()) {
+                for (const SinkEntry& _entry : m_sinks) {
+                    _entry.sink->write_trace(*_event);
+                } // end for (const SinkEntry& _entry : m_sinks)
+                _queue->queue.pop();
+            } // end if (const TraceEvent* _event = _queue->queue.take())
+        } // end while (_queue->queue.front())
         //--------------------------
-    }// end if (_log_file.is_open())
+    } // end for (const auto& _queue : m_trace_queues)
     //--------------------------
-}// end void log_file(const std::string& filename, std::string_view message) const
-//--------------------------------------------------------------
\ No newline at end of file
+    if (_closed) {
+        std::erase_if(m_trace_queues, [](const auto& queue) {
+            return queue->closed.load(std::memory_order_acquire) && queue->queue.empty();
+        });
+    } // end if (_closed)
+    //--------------------------
+} // end void Logger::Logger::drain_traces(void)
+//--------------------------------------------------------------
@@ -0,0 +1,245 @@
+//--------------------------------------------------------------
+// Main Header
+//--------------------------------------------------------------
+#include "MappedFileSink.hpp"
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+//--------------------------------------------------------------
+// POSIX
+//--------------------------------------------------------------
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+//--------------------------------------------------------------
+#if __cpp_lib_format
+    #include <format>
+#else
+    #include <fmt/core.h>
+#endif
+//--------------------------------------------------------------
+namespace {
+    //--------------------------------------------------------------
+    constexpr size_t INDEX_DIGITS = 6UL;
+    //--------------------------------------------------------------
+    // **Highest segment index present next to filename, or -1 when there is none**
+    //--------------------------------------------------------------
+    int64_t last_segment(const std::string& filename) {
+        //--------------------------
+        const std::filesystem::path _path(filename);
+        const std::filesystem::path _directory = _path.has_parent_path() ? _path.parent_path() : std::filesystem::path(".");
+        const std::string _prefix = _path.filename().string() + '.';
+        //--------------------------
+        int64_t _last = -1;
+        std::error_code _error;
+        //--------------------------
+        for (const auto& _entry : std::filesystem::directory_iterator(_directory, _error)) {
+            //--------------------------
+            const std::string _name = _entry.path().filename().string();
+            if (_name.size() != _prefix.size() + INDEX_DIGITS || !_name.starts_with(_prefix)) {
+                continue;
+            } // end if (_name.size() != _prefix.size() + INDEX_DIGITS || ...)
+            //--------------------------
+            uint32_t _index = 0;
+            const char* _begin  = _name.data() + _prefix.size();
+            const char* _end    = _name.data() + _name.size();
+            const auto _result  = std::from_chars(_begin, _end, _index);
+            if (_result.ec == std::errc() && _result.ptr == _end) {
+                _last = std::max<int64_t>(_last, _index);
+            } // end if (_result.ec == std::errc() && _result.ptr == _end)
+            //--------------------------
+        } // end for (const auto& _entry : std::filesystem::directory_iterator(_directory, _error))
+        //--------------------------
+        return _last;
+        //--------------------------
+    } // end int64_t last_segment(const std::string& filename)
+    //--------------------------------------------------------------
+} // end namespace
+//--------------------------------------------------------------
+Logger::MappedFileSink::MappedFileSink(std::string filename, const MappedFileSinkOptions& options) :    m_filename(std::move(filename)),
+                                                                                                        m_options(options),
+                                                                                                        m_index(0U),
+                                                                                                        m_fd(-1),
+                                                                                                        m_data(nullptr),
+                                                                                                        m_size(0UL),
+                                                                                                        m_used(0UL),
+                                                                                                        m_synced(0UL) {
+    //--------------------------
+    // The previous run may have died mid-segment; keep its complete lines and start a new segment
+    const int64_t _last = last_segment(m_filename);
+    if (_last >= 0) {
+        m_index = static_cast<uint32_t>(_last);
+        recover(segment_path(m_index));
+        ++m_index;
+    } // end if (_last >= 0)
+    //--------------------------
+    if (!open_segment(m_options.segment_size)) {
+        throw std::system_error(errno, std::generic_category(), "MappedFileSink: cannot map " + segment_path(m_index));
+    } // end if (!open_segment(m_options.segment_size))
+    //--------------------------
+} // end Logger::MappedFileSink::MappedFileSink(std::string filename, const MappedFileSinkOptions& options)
+//--------------------------------------------------------------
+Logger::MappedFileSink::~MappedFileSink(void) {
+    close_segment();
+} // end Logger::MappedFileSink::~MappedFileSink(void)
+//--------------------------------------------------------------
+void Logger::MappedFileSink::write(const LogRecord& record, std::string_view formatted) {
+    //--------------------------
+    static_cast<void>(record);
+    //--------------------------
+    const size_t _length = formatted.size() + 1UL;
+    //--------------------------
+    if (!m_data || m_used + _length > m_size) {
+        close_segment();
+        if (!open_segment(std::max(m_options.segment_size, _length))) {
+            return;
+        } // end if (!open_segment(std::max(m_options.segment_size, _length)))
+    } // end if (!m_data || m_used + _length > m_size)
+    //--------------------------
+    std::memcpy(m_data + m_used, formatted.data(), formatted.size());
+    m_data[m_used + formatted.size()] = '\n';
+    m_used += _length;
+    //--------------------------
+} // end void Logger::MappedFileSink::write(const LogRecord& record, std::string_view formatted)
+//--------------------------------------------------------------
+void Logger::MappedFileSink::flush(void) {
+    //--------------------------
+    // The mapping is already part of the page cache; only FDATASYNC has to reach the disk
+    if (m_options.durability != Durability::FDATASYNC || !m_data || m_used == m_synced) {
+        return;
+    } // end if (m_options.durability != Durability::FDATASYNC || ...)
+    //--------------------------
+    const size_t _page  = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t _begin = m_synced - m_synced % _page;
+    //--------------------------
+    msync(m_data + _begin, m_used - _begin, MS_SYNC);
+    m_synced = m_used;
+    //--------------------------
+} // end void Logger::MappedFileSink::flush(void)
+//--------------------------------------------------------------
+int64_t Logger::MappedFileSink::recover(const std::string& path) {
+    //--------------------------
+    const int _fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+    if (_fd < 0) {
+        return -1;
+    } // end if (_fd < 0)
+    //--------------------------
+    struct stat _stat;
+    if (fstat(_fd, &_stat) != 0) {
+        ::close(_fd);
+        return -1;
+    } // end if (fstat(_fd, &_stat) != 0)
+    //--------------------------
+    // Everything after the last newline is either preallocated zeros or a torn record
+    std::array<char, 64UL * 1024UL> _chunk;
+    off_t _end      = _stat.st_size;
+    off_t _length   = 0;
+    //--------------------------
+    while (_end > 0) {
+        //--------------------------
+        const off_t _begin  = std::max<off_t>(0, _end - static_cast<off_t>(_chunk.size()));
+        const ssize_t _read = pread(_fd, _chunk.data(), static_cast<size_t>(_end - _begin), _begin);
+        if (_read != _end - _begin) {
+            ::close(_fd);
+            return -1;
+        } // end if (_read != _end - _begin)
+        //--------------------------
+        const auto _newline = std::find(std::make_reverse_iterator(_chunk.begin() + _read),
+                                        std::make_reverse_iterator(_chunk.begin()), '\n');
+        if (_newline.base() != _chunk.begin()) {
+            _length = _begin + (_newline.base() - _chunk.begin());
+            break;
+        } // end if (_newline.base() != _chunk.begin())
+        //--------------------------
+        _end = _begin;
+        //--------------------------
+    } // end while (_end > 0)
+    //--------------------------
+    const bool _truncated = _length == _stat.st_size || ftruncate(_fd, _length) == 0;
+    ::close(_fd);
+    //--------------------------
+    return _truncated ? static_cast<int64_t>(_length) : -1;
+    //--------------------------
+} // end int64_t Logger::MappedFileSink::recover(const std::string& path)
+//--------------------------------------------------------------
+std::string Logger::MappedFileSink::segment_path(const uint32_t& index) const {
+#if __cpp_lib_format
+    return std::format("{}.{:06}", m_filename, index);
+#else
+    return fmt::format("{}.{:06}", m_filename, index);
+#endif
+} // end std::string Logger::MappedFileSink::segment_path(const uint32_t& index) const
+//--------------------------------------------------------------
+bool Logger::MappedFileSink::open_segment(const size_t& size) {
+    //--------------------------
+    const std::string _path = segment_path(m_index);
+    //--------------------------
+    m_fd = ::open(_path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (m_fd < 0) {
+        return false;
+    } // end if (m_fd < 0)
+    //--------------------------
+    // Reserve the blocks up front so filling the mapping never runs into ENOSPC as SIGBUS
+#if defined(__linux__)
+    const int _error = posix_fallocate(m_fd, 0, static_cast<off_t>(size));
+#else
+    const int _error = ftruncate(m_fd, static_cast<off_t>(size)) == 0 ? 0 : errno;
+#endif
+    //--------------------------
+    void* _data = MAP_FAILED;
+    if (!_error) {
+        _data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    } else {
+        errno = _error;
+    } // end if (!_error)
+    //--------------------------
+    if (_data == MAP_FAILED) {
+        const int _saved = errno;
+        ::close(m_fd);
+        ::unlink(_path.c_str());
+        m_fd    = -1;
+        errno   = _saved;
+        return false;
+    } // end if (_data == MAP_FAILED)
+    //--------------------------
+    madvise(_data, size, MADV_SEQUENTIAL);
+    //--------------------------
+    m_data      = static_cast<char*>(_data);
+    m_size      = size;
+    m_used      = 0UL;
+    m_synced    = 0UL;
+    //--------------------------
+    return true;
+    //--------------------------
+} // end bool Logger::MappedFileSink::open_segment(const size_t& size)
+//--------------------------------------------------------------
+void Logger::MappedFileSink::close_segment(void) {
+    //--------------------------
+    if (m_fd < 0) {
+        return;
+    } // end if (m_fd < 0)
+    //--------------------------
+    flush();
+    munmap(m_data, m_size);
+    //--------------------------
+    // Drop the unused preallocated tail
+    static_cast<void>(ftruncate(m_fd, static_cast<off_t>(m_used)));
+    ::close(m_fd);
+    //--------------------------
+    m_fd    = -1;
+    m_data  = nullptr;
+    m_size  = 0UL;
+    m_used  = 0UL;
+    ++m_index;
+    //--------------------------
+} // end void Logger::MappedFileSink::close_segment(void)
+//--------------------------------------------------------------
@@ -0,0 +1,158 @@
+//--------------------------------------------------------------
+// Main Header
+//--------------------------------------------------------------
+#include "Metrics.hpp"
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <cstdio>
+#include <iterator>
+#include <string_view>
+//--------------------------------------------------------------
+#if __cpp_lib_format
+    #include <format>
+#else
+    #include <fmt/core.h>
+#endif
+//--------------------------------------------------------------
+namespace {
+    //--------------------------------------------------------------
+    template<typename... Args>
+    void append(std::string& output, std::string_view format, const Args&... args) {
+#if __cpp_lib_format
+        std::vformat_to(std::back_inserter(output), format, std::make_format_args(args...));
+#else
+        fmt::format_to(std::back_inserter(output), fmt::runtime(format), args...);
+#endif
+    } // end void append(std::string& output, std::string_view format, const Args&... args)
+    //--------------------------------------------------------------
+    void header(std::string& output, std::string_view name, std::string_view type, std::string_view help) {
+        append(output, "# HELP {} {}\n# TYPE {} {}\n", name, help, name, type);
+    } // end void header(std::string& output, std::string_view name, std::string_view type, std::string_view help)
+    //--------------------------------------------------------------
+    double seconds(const uint64_t& nanoseconds) {
+        return static_cast<double>(nanoseconds) / 1e9;
+    } // end double seconds(const uint64_t& nanoseconds)
+    //--------------------------------------------------------------
+    void per_level(std::string& output, std::string_view name, std::string_view help,
+                   const std::array<uint64_t, Logger::LEVEL_COUNT>& values) {
+        //--------------------------
+        header(output, name, "counter", help);
+        for (const Logger::LogLevel& _level : Logger::LEVELS) {
+            append(output, "{}{{level=\"{}\"}} {}\n", name, Logger::level_name(_level), values[Logger::level_index(_level)]);
+        } // end for (const Logger::LogLevel& _level : Logger::LEVELS)
+        //--------------------------
+    } // end void per_level(...)
+    //--------------------------------------------------------------
+    // **Label values escape backslashes, quotes and newlines**
+    //--------------------------------------------------------------
+    std::string label(std::string_view value) {
+        //--------------------------
+        std::string _label;
+        for (const char& _character : value) {
+            switch (_character) {
+                case '\\':  _label.append("\\\\");   break;
+                case '"':   _label.append("\\\"");   break;
+                case '\n':  _label.append("\\n");    break;
+                default:    _label.push_back(_character);
+            } // end switch (_character)
+        } // end for (const char& _character : value)
+        //--------------------------
+        return _label;
+        //--------------------------
+    } // end std::string label(std::string_view value)
+    //--------------------------------------------------------------
+} // end namespace
+//--------------------------------------------------------------
+void Logger::MetricsShard::collect(MetricsSnapshot& snapshot) const {
+    //--------------------------
+    for (size_t i = 0; i < LEVEL_COUNT; ++i) {
+        snapshot.messages[i] += messages[i].load(std::memory_order_relaxed);
+    } // end for (size_t i = 0; i < LEVEL_COUNT; ++i)
+    //--------------------------
+    for (size_t i = 0; i < LATENCY_BUCKETS; ++i) {
+        snapshot.latency[i] += latency[i].load(std::memory_order_relaxed);
+    } // end for (size_t i = 0; i < LATENCY_BUCKETS; ++i)
+    //--------------------------
+    snapshot.latency_nanoseconds    += latency_nanoseconds.load(std::memory_order_relaxed);
+    snapshot.lock_waits             += lock_waits.load(std::memory_order_relaxed);
+    snapshot.lock_wait_nanoseconds  += lock_wait_nanoseconds.load(std::memory_order_relaxed);
+    //--------------------------
+} // end void Logger::MetricsShard::collect(MetricsSnapshot& snapshot) const
+//--------------------------------------------------------------
+uint64_t Logger::MetricsSnapshot::calls(void) const {
+    //--------------------------
+    uint64_t _calls = 0UL;
+    for (const uint64_t& _count : latency) {
+        _calls += _count;
+    } // end for (const uint64_t& _count : latency)
+    //--------------------------
+    return _calls;
+    //--------------------------
+} // end uint64_t Logger::MetricsSnapshot::calls(void) const
+//--------------------------------------------------------------
+void Logger::MetricsSnapshot::write_prometheus(std::string& output) const {
+    //--------------------------
+    per_level(output, "logger_messages_total", "Log calls that reached the logger, dropped ones included.", messages);
+    per_level(output, "logger_bytes_total", "Bytes of message and field text written.", bytes);
+    per_level(output, "logger_dropped_total", "Records dropped or overwritten under backpressure.", dropped);
+    //--------------------------
+    header(output, "logger_queue_high_water", "gauge", "Most records the writer found queued in one thread ring in one pass.");
+    append(output, "logger_queue_high_water {}\n", queue_high_water);
+    //--------------------------
+    header(output, "logger_lock_waits_total", "counter", "Acquisitions of the write lock that had to wait.");
+    append(output, "logger_lock_waits_total {}\n", lock_waits);
+    header(output, "logger_lock_wait_seconds_total", "counter", "Time spent waiting for the write lock.");
+    append(output, "logger_lock_wait_seconds_total {}\n", seconds(lock_wait_nanoseconds));
+    //--------------------------
+    header(output, "logger_sink_writes_total", "counter", "Records written per sink.");
+    for (const SinkMetrics& _sink : sinks) {
+        append(output, "logger_sink_writes_total{{sink=\"{}\"}} {}\n", label(_sink.name), _sink.writes);
+    } // end for (const SinkMetrics& _sink : sinks)
+    header(output, "logger_sink_write_seconds_total", "counter", "Time spent in the write call per sink.");
+    for (const SinkMetrics& _sink : sinks) {
+        append(output, "logger_sink_write_seconds_total{{sink=\"{}\"}} {}\n", label(_sink.name), seconds(_sink.write_nanoseconds));
+    } // end for (const SinkMetrics& _sink : sinks)
+    header(output, "logger_sink_flushes_total", "counter", "Flushes per sink.");
+    for (const SinkMetrics& _sink : sinks) {
+        append(output, "logger_sink_flushes_total{{sink=\"{}\"}} {}\n", label(_sink.name), _sink.flushes);
+    } // end for (const SinkMetrics& _sink : sinks)
+    header(output, "logger_sink_flush_seconds_total", "counter", "Time spent in the flush call per sink.");
+    for (const SinkMetrics& _sink : sinks) {
+        append(output, "logger_sink_flush_seconds_total{{sink=\"{}\"}} {}\n", label(_sink.name), seconds(_sink.flush_nanoseconds));
+    } // end for (const SinkMetrics& _sink : sinks)
+    //--------------------------
+    header(output, "logger_call_latency_seconds", "histogram", "Time spent in a log call by the calling thread.");
+    uint64_t _cumulative = 0UL;
+    for (size_t i = 0; i + 1UL < LATENCY_BUCKETS; ++i) {
+        _cumulative += latency[i];
+        append(output, "logger_call_latency_seconds_bucket{{le=\"{}\"}} {}\n", seconds(latency_bound(i)), _cumulative);
+    } // end for (size_t i = 0; i + 1UL < LATENCY_BUCKETS; ++i)
+    _cumulative += latency[LATENCY_BUCKETS - 1UL];
+    append(output, "logger_call_latency_seconds_bucket{{le=\"+Inf\"}} {}\n", _cumulative);
+    append(output, "logger_call_latency_seconds_sum {}\n", seconds(latency_nanoseconds));
+    append(output, "logger_call_latency_seconds_count {}\n", _cumulative);
+    //--------------------------
+} // end void Logger::MetricsSnapshot::write_prometheus(std::string& output) const
+//--------------------------------------------------------------
+bool Logger::MetricsSnapshot::write_prometheus_file(const std::string& filename) const {
+    //--------------------------
+    std::string _text;
+    write_prometheus(_text);
+    //--------------------------
+    const std::string _temporary = filename + ".tmp";
+    std::FILE* _file = std::fopen(_temporary.c_str(), "wb");
+    if (!_file) {
+        return false;
+    } // end if (!_file)
+    //--------------------------
+    const bool _written = std::fwrite(_text.data(), 1UL, _text.size(), _file) == _text.size();
+    if (std::fclose(_file) != 0 || !_written) {
+        std::remove(_temporary.c_str());
+        return false;
+    } // end if (std::fclose(_file) != 0 || !_written)
+    //--------------------------
+    return std::rename(_temporary.c_str(), filename.c_str()) == 0;
+    //--------------------------
+} // end bool Logger::MetricsSnapshot::write_prometheus_file(const std::string& filename) const
+//--------------------------------------------------------------
@@ -0,0 +1,230 @@
+//--------------------------------------------------------------
+// Main Header
+//--------------------------------------------------------------
+#include "Timestamp.hpp"
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <ctime>
+#include <cstring>
+#include <mutex>
+#include <thread>
+//--------------------------------------------------------------
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #define LOGGER_HAS_TSC 1
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #include <x86intrin.h>
+    #include <cpuid.h>
+    #define LOGGER_HAS_TSC 1
+#else
+    #define LOGGER_HAS_TSC 0
+#endif
+//--------------------------------------------------------------
+std::atomic<bool> Logger::TscClock::s_calibrated{false};
+std::atomic<uint64_t> Logger::TscClock::s_sequence{0UL};
+std::atomic<uint64_t> Logger::TscClock::s_base_ticks{0UL};
+std::atomic<int64_t> Logger::TscClock::s_base_nanoseconds{0L};
+std::atomic<double> Logger::TscClock::s_nanoseconds_per_tick{1.0};
+std::atomic<Logger::TimestampPrecision> Logger::Timestamp::s_precision{Logger::TimestampPrecision::SECONDS};
+//--------------------------------------------------------------
+namespace {
+    //--------------------------------------------------------------
+    int64_t system_nanoseconds(void) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    } // end int64_t system_nanoseconds(void)
+    //--------------------------------------------------------------
+    struct SecondCache {
+        int64_t second = INT64_MIN;
+        char text[Logger::Timestamp::SECONDS_LENGTH];
+    }; // end struct SecondCache
+    //--------------------------------------------------------------
+    thread_local SecondCache t_cache;
+    //--------------------------------------------------------------
+#if LOGGER_HAS_TSC
+    // **CPUID 0x80000007 EDX bit 8: the counter ticks at a constant rate through P- and C-states**
+    bool has_invariant_tsc(void) {
+        //--------------------------
+        constexpr unsigned int _leaf = 0x80000007U;
+    #if defined(_MSC_VER)
+        int _registers[4];
+        __cpuid(_registers, static_cast<int>(0x80000000U));
+        if (static_cast<unsigned int>(_registers[0]) < _leaf) {
+            return false;
+        } // end if (static_cast<unsigned int>(_registers[0]) < _leaf)
+        __cpuid(_registers, static_cast<int>(_leaf));
+        return (static_cast<unsigned int>(_registers[3]) >> 8U) & 1U;
+    #else
+        unsigned int _eax = 0U, _ebx = 0U, _ecx = 0U, _edx = 0U;
+        if (!__get_cpuid(_leaf, &_eax, &_ebx, &_ecx, &_edx)) {
+            return false;
+        } // end if (!__get_cpuid(_leaf, &_eax, &_ebx, &_ecx, &_edx))
+        return (_edx >> 8U) & 1U;
+    #endif
+        //--------------------------
+    } // end bool has_invariant_tsc(void)
+    //--------------------------------------------------------------
+    std::mutex g_calibration_mutex;
+#endif
+    //--------------------------------------------------------------
+} // end namespace
+//--------------------------------------------------------------
+bool Logger::TscClock::calibrate(const std::chrono::milliseconds& duration) {
+    //--------------------------
+#if LOGGER_HAS_TSC
+    static const bool s_invariant = has_invariant_tsc();
+    if (!s_invariant) {
+        return false;
+    } // end if (!s_invariant)
+    //--------------------------
+    const uint64_t _start_ticks     = __rdtsc();
+    const int64_t _start_time       = system_nanoseconds();
+    //--------------------------
+    std::this_thread::sleep_for(duration);
+    //--------------------------
+    const uint64_t _end_ticks       = __rdtsc();
+    const int64_t _end_time         = system_nanoseconds();
+    //--------------------------
+    if (_end_ticks <= _start_ticks || _end_time <= _start_time) {
+        return false;
+    } // end if (_end_ticks <= _start_ticks || _end_time <= _start_time)
+    //--------------------------
+    // Concurrent calibrations take turns, readers retry while the sequence is odd or moved
+    {
+        std::lock_guard<std::mutex> lock(g_calibration_mutex);
+        const uint64_t _sequence = s_sequence.load(std::memory_order_relaxed);
+        s_sequence.store(_sequence + 1UL, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        s_nanoseconds_per_tick.store(static_cast<double>(_end_time - _start_time) / static_cast<double>(_end_ticks - _start_ticks),
+                                     std::memory_order_relaxed);
+        s_base_ticks.store(_end_ticks, std::memory_order_relaxed);
+        s_base_nanoseconds.store(_end_time, std::memory_order_relaxed);
+        s_sequence.store(_sequence + 2UL, std::memory_order_release);
+    }
+    s_calibrated.store(true, std::memory_order_release);
+    //--------------------------
+    return true;
+#else
+    static_cast<void>(duration);
+    return false;
+#endif
+    //--------------------------
+} // end bool Logger::TscClock::calibrate(const std::chrono::milliseconds& duration)
+//--------------------------------------------------------------
+bool Logger::TscClock::is_calibrated(void) {
+    return s_calibrated.load(std::memory_order_acquire);
+} // end bool Logger::TscClock::is_calibrated(void)
+//--------------------------------------------------------------
+uint64_t Logger::TscClock::ticks(void) {
+#if LOGGER_HAS_TSC
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+} // end uint64_t Logger::TscClock::ticks(void)
+//--------------------------------------------------------------
+std::chrono::system_clock::time_point Logger::TscClock::now(void) {
+    //--------------------------
+    if (!s_calibrated.load(std::memory_order_acquire)) {
+        return std::chrono::system_clock::now();
+    } // end if (!s_calibrated.load(std::memory_order_acquire))
+    //--------------------------
+    return to_time_point(ticks());
+    //--------------------------
+} // end std::chrono::system_clock::time_point Logger::TscClock::now(void)
+//--------------------------------------------------------------
+std::chrono::system_clock::time_point Logger::TscClock::to_time_point(const uint64_t& ticks) {
+    //--------------------------
+    uint64_t _sequence, _base_ticks;
+    int64_t _base_nanoseconds;
+    double _nanoseconds_per_tick;
+    do {
+        _sequence               = s_sequence.load(std::memory_order_acquire);
+        _nanoseconds_per_tick   = s_nanoseconds_per_tick.load(std::memory_order_relaxed);
+        _base_ticks             = s_base_ticks.load(std::memory_order_relaxed);
+        _base_nanoseconds       = s_base_nanoseconds.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((_sequence & 1UL) || _sequence != s_sequence.load(std::memory_order_relaxed));
+    //--------------------------
+    const double _elapsed = static_cast<double>(static_cast<int64_t>(ticks - _base_ticks)) * _nanoseconds_per_tick;
+    const std::chrono::nanoseconds _time(_base_nanoseconds + static_cast<int64_t>(_elapsed));
+    //--------------------------
+    return std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(_time));
+    //--------------------------
+} // end std::chrono::system_clock::time_point Logger::TscClock::to_time_point(const uint64_t& ticks)
+//--------------------------------------------------------------
+void Logger::Timestamp::set_precision(const TimestampPrecision& precision) {
+    s_precision.store(precision, std::memory_order_relaxed);
+} // end void Logger::Timestamp::set_precision(const TimestampPrecision& precision)
+//--------------------------------------------------------------
+Logger::TimestampPrecision Logger::Timestamp::precision(void) {
+    return s_precision.load(std::memory_order_relaxed);
+} // end Logger::TimestampPrecision Logger::Timestamp::precision(void)
+//--------------------------------------------------------------
+void Logger::Timestamp::write_digits(char* buffer, uint64_t value, const size_t& digits) {
+    for (size_t i = digits; i > 0; --i) {
+        buffer[i - 1UL] = static_cast<char>('0' + value % 10UL);
+        value /= 10UL;
+    } // end for (size_t i = digits; i > 0; --i)
+} // end void Logger::Timestamp::write_digits(char* buffer, uint64_t value, const size_t& digits)
+//--------------------------------------------------------------
+size_t Logger::Timestamp::format(const std::chrono::system_clock::time_point& time, char* buffer) {
+    return format(time, buffer, s_precision.load(std::memory_order_relaxed));
+} // end size_t Logger::Timestamp::format(const std::chrono::system_clock::time_point& time, char* buffer)
+//--------------------------------------------------------------
+size_t Logger::Timestamp::format(const std::chrono::system_clock::time_point& time, char* buffer, const TimestampPrecision& precision) {
+    //--------------------------
+    const int64_t _nanoseconds  = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    int64_t _second             = _nanoseconds / 1'000'000'000L;
+    int64_t _fraction           = _nanoseconds % 1'000'000'000L;
+    if (_fraction < 0) {
+        _fraction += 1'000'000'000L;
+        --_second;
+    } // end if (_fraction < 0)
+    //--------------------------
+    if (t_cache.second != _second) {
+        //--------------------------
+        const auto _time = static_cast<std::time_t>(_second);
+        std::tm _local{};
+#if defined(_WIN32)
+        localtime_s(&_local, &_time);
+#else
+        localtime_r(&_time, &_local);
+#endif
+        //--------------------------
+        char* _text = t_cache.text;
+        write_digits(_text, static_cast<uint64_t>(_local.tm_year + 1900), 4UL);
+        _text[4] = '-';
+        write_digits(_text + 5, static_cast<uint64_t>(_local.tm_mon + 1), 2UL);
+        _text[7] = '-';
+        write_digits(_text + 8, static_cast<uint64_t>(_local.tm_mday), 2UL);
+        _text[10] = ' ';
+        write_digits(_text + 11, static_cast<uint64_t>(_local.tm_hour), 2UL);
+        _text[13] = ':';
+        write_digits(_text + 14, static_cast<uint64_t>(_local.tm_min), 2UL);
+        _text[16] = ':';
+        write_digits(_text + 17, static_cast<uint64_t>(_local.tm_sec), 2UL);
+        //--------------------------
+        t_cache.second = _second;
+        //--------------------------
+    } // end if (t_cache.second != _second)
+    //--------------------------
+    std::memcpy(buffer, t_cache.text, SECONDS_LENGTH);
+    //--------------------------
+    const auto _digits = static_cast<size_t>(precision);
+    if (!_digits) {
+        return SECONDS_LENGTH;
+    } // end if (!_digits)
+    //--------------------------
+    uint64_t _value = static_cast<uint64_t>(_fraction);
+    for (size_t i = _digits; i < 9UL; ++i) {
+        _value /= 10UL;
+    } // end for (size_t i = _digits; i < 9UL; ++i)
+    //--------------------------
+    buffer[SECONDS_LENGTH] = '.';
+    write_digits(buffer + SECONDS_LENGTH + 1UL, _value, _digits);
+    //--------------------------
+    return SECONDS_LENGTH + 1UL + _digits;
+    //--------------------------
+} // end size_t Logger::Timestamp::format(const std::chrono::system_clock::time_point& time, char* buffer, const TimestampPrecision& precision)
+//--------------------------------------------------------------
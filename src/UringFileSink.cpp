@@ -0,0 +1,495 @@
+//--------------------------------------------------------------
+// Main Header
+//--------------------------------------------------------------
+#include "UringFileSink.hpp"
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <vector>
+//--------------------------------------------------------------
+#if defined(LOGGER_USE_IO_URING) && defined(__linux__)
+    #include <fcntl.h>
+    #include <linux/io_uring.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <sys/syscall.h>
+    #include <sys/uio.h>
+    #include <unistd.h>
+#endif
+//--------------------------------------------------------------
+#if defined(LOGGER_USE_IO_URING) && defined(__linux__)
+//--------------------------------------------------------------
+// **io_uring driven through its system calls, no liburing needed**
+//--------------------------------------------------------------
+class Logger::UringFileSink::Ring {
+    //--------------------------------------------------------------
+    public:
+        //--------------------------------------------------------------
+        Ring(void) = default;
+        //--------------------------
+        Ring(const Ring&)               = delete;
+        Ring& operator=(const Ring&)    = delete;
+        Ring(Ring&&)                    = delete;
+        Ring& operator=(Ring&&)         = delete;
+        //--------------------------
+        ~Ring(void) {
+            //--------------------------
+            if (m_ring >= 0 && m_file >= 0) {
+                flush();
+            } // end if (m_ring >= 0 && m_file >= 0)
+            //--------------------------
+            if (m_sqes) {
+                munmap(m_sqes, m_sqes_size);
+            } // end if (m_sqes)
+            if (m_cq_map && m_cq_map != m_sq_map) {
+                munmap(m_cq_map, m_cq_map_size);
+            } // end if (m_cq_map && m_cq_map != m_sq_map)
+            if (m_sq_map) {
+                munmap(m_sq_map, m_sq_map_size);
+            } // end if (m_sq_map)
+            if (m_ring >= 0) {
+                close(m_ring); // Also unregisters the buffers
+            } // end if (m_ring >= 0)
+            if (m_file >= 0) {
+                close(m_file);
+            } // end if (m_file >= 0)
+            std::free(m_memory);
+            //--------------------------
+        } // end ~Ring(void)
+        //--------------------------
+        bool open(const std::string& filename, const UringFileSinkOptions& options, const std::chrono::system_clock::time_point& created) {
+            //--------------------------
+            m_options   = options.file;
+            m_capacity  = std::max<size_t>(options.file.buffer_size, 4096UL);
+            //--------------------------
+            // One submission queue slot per buffer plus as many for the fdatasyncs that follow them
+            const auto _count = static_cast<unsigned>(std::max<size_t>(options.buffers, 2UL));
+            io_uring_params _params{};
+            m_ring = static_cast<int>(syscall(__NR_io_uring_setup, 2U * _count, &_params));
+            if (m_ring < 0) {
+                return false;
+            } // end if (m_ring < 0)
+            //--------------------------
+            if (!map(_params)) {
+                return false;
+            } // end if (!map(_params))
+            //--------------------------
+            // Registered buffers are pinned; without enough locked memory plain writes are used
+            m_memory = static_cast<char*>(std::aligned_alloc(4096UL, _count * m_capacity));
+            if (!m_memory) {
+                return false;
+            } // end if (!m_memory)
+            //--------------------------
+            std::vector<iovec> _vectors(_count);
+            m_buffers.resize(_count);
+            for (unsigned i = 0; i < _count; ++i) {
+                m_buffers[i].data       = m_memory + i * m_capacity;
+                _vectors[i].iov_base    = m_buffers[i].data;
+                _vectors[i].iov_len     = m_capacity;
+            } // end for (unsigned i = 0; i < _count; ++i)
+            m_fixed = syscall(__NR_io_uring_register, m_ring, IORING_REGISTER_BUFFERS, _vectors.data(), _count) == 0;
+            //--------------------------
+            // No O_APPEND: writes complete in any order, each one carries its own offset
+            m_file = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+            if (m_file < 0) {
+                return false;
+            } // end if (m_file < 0)
+            //--------------------------
+            struct stat _status{};
+            if (fstat(m_file, &_status) != 0) {
+                return false;
+            } // end if (fstat(m_file, &_status) != 0)
+            m_offset        = static_cast<uint64_t>(_status.st_size);
+            m_last_commit   = std::chrono::steady_clock::now();
+            //--------------------------
+            // Same stamp as FileSink: when the sink was made
+            if (m_options.header && !m_offset) {
+                append(FileSink::header(created));
+            } // end if (m_options.header && !m_offset)
+            //--------------------------
+            return true;
+            //--------------------------
+        } // end bool open(const std::string& filename, const UringFileSinkOptions& options, ...)
+        //--------------------------
+        void append(std::string_view data) {
+            //--------------------------
+            while (!data.empty()) {
+                //--------------------------
+                Buffer& _buffer     = m_buffers[m_current];
+                const size_t _size  = std::min(m_capacity - _buffer.size, data.size());
+                std::memcpy(_buffer.data + _buffer.size, data.data(), _size);
+                _buffer.size += _size;
+                data.remove_prefix(_size);
+                //--------------------------
+                if (_buffer.size == m_capacity) {
+                    commit();
+                } // end if (_buffer.size == m_capacity)
+                //--------------------------
+            } // end while (!data.empty())
+            //--------------------------
+        } // end void append(std::string_view data)
+        //--------------------------
+        void poll(const std::chrono::steady_clock::time_point& now) {
+            //--------------------------
+            reap(false);
+            //--------------------------
+            // Without batching nothing else polls, so every write is submitted
+            if (m_options.durability != Durability::NONE && (!m_batching || now - m_last_commit >= m_options.flush_interval)) {
+                commit();
+            } // end if (m_options.durability != Durability::NONE && ...)
+            //--------------------------
+        } // end void poll(const std::chrono::steady_clock::time_point& now)
+        //--------------------------
+        void set_batching(const bool& enabled) {
+            //--------------------------
+            if (!enabled) {
+                commit();
+            } // end if (!enabled)
+            m_batching = enabled;
+            //--------------------------
+        } // end void set_batching(const bool& enabled)
+        //--------------------------
+        void flush(void) {
+            //--------------------------
+            commit();
+            //--------------------------
+            while (m_in_flight) {
+                reap(true);
+            } // end while (m_in_flight)
+            //--------------------------
+        } // end void flush(void)
+        //--------------------------
+        // **Async-signal-safe: writes the bytes not submitted yet with pwrite(2)**
+        void write_pending(void) noexcept {
+            //--------------------------
+            Buffer& _buffer = m_buffers[m_current];
+            //--------------------------
+            size_t _done = 0UL;
+            while (_done < _buffer.size) {
+                const ssize_t _written = pwrite(m_file, _buffer.data + _done, _buffer.size - _done, static_cast<off_t>(m_offset + _done));
+                if (_written < 0 && errno == EINTR) {
+                    continue;
+                } // end if (_written < 0 && errno == EINTR)
+                if (_written <= 0) {
+                    break;
+                } // end if (_written <= 0)
+                _done += static_cast<size_t>(_written);
+            } // end while (_done < _buffer.size)
+            //--------------------------
+            m_offset += _buffer.size;
+            _buffer.size = 0UL;
+            //--------------------------
+        } // end void write_pending(void) noexcept
+        //--------------------------------------------------------------
+    private:
+        //--------------------------------------------------------------
+        static constexpr uint64_t SYNC = UINT64_MAX; // user_data of the fdatasync completions
+        //--------------------------
+        struct Buffer {
+            char* data      = nullptr;
+            size_t size     = 0UL;      // Bytes collected
+            size_t done     = 0UL;      // Bytes the kernel reported written
+            uint64_t offset = 0UL;      // File offset of data[0] once submitted
+            bool busy       = false;    // Owned by the kernel until its write completes
+        }; // end struct Buffer
+        //--------------------------
+        bool map(const io_uring_params& params) {
+            //--------------------------
+            m_entries       = params.sq_entries;
+            m_sq_map_size   = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            m_cq_map_size   = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            //--------------------------
+            const bool _single = params.features & IORING_FEAT_SINGLE_MMAP;
+            if (_single) {
+                m_sq_map_size = m_cq_map_size = std::max(m_sq_map_size, m_cq_map_size);
+            } // end if (_single)
+            //--------------------------
+            m_sq_map = mmap(nullptr, m_sq_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring, IORING_OFF_SQ_RING);
+            if (m_sq_map == MAP_FAILED) {
+                m_sq_map = nullptr;
+                return false;
+            } // end if (m_sq_map == MAP_FAILED)
+            //--------------------------
+            m_cq_map = _single ? m_sq_map : mmap(nullptr, m_cq_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring, IORING_OFF_CQ_RING);
+            if (m_cq_map == MAP_FAILED) {
+                m_cq_map = nullptr;
+                return false;
+            } // end if (m_cq_map == MAP_FAILED)
+            //--------------------------
+            m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+            void* _sqes = mmap(nullptr, m_sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring, IORING_OFF_SQES);
+            if (_sqes == MAP_FAILED) {
+                return false;
+            } // end if (_sqes == MAP_FAILED)
+            m_sqes = static_cast<io_uring_sqe*>(_sqes);
+            //--------------------------
+            char* _sq = static_cast<char*>(m_sq_map);
+            m_sq_tail   = reinterpret_cast<unsigned*>(_sq + params.sq_off.tail);
+            m_sq_mask   = *reinterpret_cast<unsigned*>(_sq + params.sq_off.ring_mask);
+            m_sq_array  = reinterpret_cast<unsigned*>(_sq + params.sq_off.array);
+            //--------------------------
+            char* _cq = static_cast<char*>(m_cq_map);
+            m_cq_head   = reinterpret_cast<unsigned*>(_cq + params.cq_off.head);
+            m_cq_tail   = reinterpret_cast<unsigned*>(_cq + params.cq_off.tail);
+            m_cq_mask   = *reinterpret_cast<unsigned*>(_cq + params.cq_off.ring_mask);
+            m_cqes      = reinterpret_cast<io_uring_cqe*>(_cq + params.cq_off.cqes);
+            //--------------------------
+            return true;
+            //--------------------------
+        } // end bool map(const io_uring_params& params)
+        //--------------------------
+        // **Submits the current buffer and moves on to the next one, waiting only if that one is still in flight**
+        void commit(void) {
+            //--------------------------
+            m_last_commit = std::chrono::steady_clock::now();
+            //--------------------------
+            Buffer& _buffer = m_buffers[m_current];
+            if (!_buffer.size) {
+                return;
+            } // end if (!_buffer.size)
+            //--------------------------
+            _buffer.offset  = m_offset;
+            _buffer.done    = 0UL;
+            _buffer.busy    = true;
+            m_offset += _buffer.size;
+            submit_write(m_current);
+            //--------------------------
+            if (m_options.durability == Durability::FDATASYNC) {
+                submit_sync();
+            } // end if (m_options.durability == Durability::FDATASYNC)
+            //--------------------------
+            m_current = (m_current + 1UL) % m_buffers.size();
+            while (m_buffers[m_current].busy) {
+                reap(true);
+            } // end while (m_buffers[m_current].busy)
+            //--------------------------
+        } // end void commit(void)
+        //--------------------------
+        io_uring_sqe& next_sqe(void) {
+            //--------------------------
+            // Bounding the operations in flight by the queue size keeps both rings from overflowing
+            while (m_in_flight >= m_entries) {
+                reap(true);
+            } // end while (m_in_flight >= m_entries)
+            //--------------------------
+            const unsigned _index = *m_sq_tail & m_sq_mask;
+            io_uring_sqe& _sqe = m_sqes[_index];
+            std::memset(&_sqe, 0, sizeof(_sqe));
+            m_sq_array[_index] = _index;
+            //--------------------------
+            return _sqe;
+            //--------------------------
+        } // end io_uring_sqe& next_sqe(void)
+        //--------------------------
+        void submit_write(const size_t& index) {
+            //--------------------------
+            const Buffer& _buffer = m_buffers[index];
+            io_uring_sqe& _sqe = next_sqe();
+            //--------------------------
+            _sqe.opcode     = m_fixed ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+            _sqe.fd         = m_file;
+            _sqe.addr       = reinterpret_cast<uint64_t>(_buffer.data + _buffer.done);
+            _sqe.len        = static_cast<uint32_t>(_buffer.size - _buffer.done);
+            _sqe.off        = _buffer.offset + _buffer.done;
+            _sqe.buf_index  = static_cast<uint16_t>(m_fixed ? index : 0UL);
+            _sqe.user_data  = index;
+            //--------------------------
+            submit();
+            //--------------------------
+        } // end void submit_write(const size_t& index)
+        //--------------------------
+        void submit_sync(void) {
+            //--------------------------
+            io_uring_sqe& _sqe = next_sqe();
+            //--------------------------
+            _sqe.opcode         = IORING_OP_FSYNC;
+            _sqe.flags          = IOSQE_IO_DRAIN; // After every write submitted before it
+            _sqe.fd             = m_file;
+            _sqe.fsync_flags    = IORING_FSYNC_DATASYNC;
+            _sqe.user_data      = SYNC;
+            //--------------------------
+            submit();
+            //--------------------------
+        } // end void submit_sync(void)
+        //--------------------------
+        void submit(void) {
+            //--------------------------
+            std::atomic_ref<unsigned>(*m_sq_tail).store(*m_sq_tail + 1U, std::memory_order_release);
+            ++m_in_flight;
+            //--------------------------
+            while (syscall(__NR_io_uring_enter, m_ring, 1U, 0U, 0U, nullptr, 0UL) < 0) {
+                if (errno == EBUSY) {
+                    reap(true); // Completions have to be taken before the kernel accepts more
+                } else if (errno != EINTR && errno != EAGAIN) {
+                    break;
+                } // end if (errno == EBUSY)
+            } // end while (syscall(__NR_io_uring_enter, ...) < 0)
+            //--------------------------
+        } // end void submit(void)
+        //--------------------------
+        // **Takes the completions, resubmitting the rest of short writes**
+        void reap(const bool& wait) {
+            //--------------------------
+            unsigned _head = *m_cq_head;
+            //--------------------------
+            if (wait && _head == std::atomic_ref<unsigned>(*m_cq_tail).load(std::memory_order_acquire)) {
+                syscall(__NR_io_uring_enter, m_ring, 0U, 1U, IORING_ENTER_GETEVENTS, nullptr, 0UL);
+            } // end if (wait && ...)
+            //--------------------------
+            while (_head != std::atomic_ref<unsigned>(*m_cq_tail).load(std::memory_order_acquire)) {
+                //--------------------------
+                const io_uring_cqe _cqe = m_cqes[_head & m_cq_mask];
+                std::atomic_ref<unsigned>(*m_cq_head).store(++_head, std::memory_order_release);
+                --m_in_flight;
+                //--------------------------
+                if (_cqe.user_data == SYNC) {
+                    continue;
+                } // end if (_cqe.user_data == SYNC)
+                //--------------------------
+                Buffer& _buffer = m_buffers[_cqe.user_data];
+                if (_cqe.res > 0) {
+                    _buffer.done += static_cast<size_t>(_cqe.res);
+                } // end if (_cqe.res > 0)
+                //--------------------------
+                const bool _retry = _cqe.res == -EINTR || _cqe.res == -EAGAIN;
+                if ((_cqe.res > 0 && _buffer.done < _buffer.size) || _retry) {
+                    submit_write(_cqe.user_data);
+                    continue;
+                } // end if ((_cqe.res > 0 && _buffer.done < _buffer.size) || _retry)
+                //--------------------------
+                // Written, or failed the way a lost fwrite() would in FileSink
+                _buffer.size = 0UL;
+                _buffer.done = 0UL;
+                _buffer.busy = false;
+                //--------------------------
+            } // end while (_head != ...)
+            //--------------------------
+        } // end void reap(const bool& wait)
+        //--------------------------------------------------------------
+        FileSinkOptions m_options;
+        int m_ring  = -1;
+        int m_file  = -1;
+        //--------------------------
+        void* m_sq_map          = nullptr;
+        void* m_cq_map          = nullptr;
+        size_t m_sq_map_size    = 0UL;
+        size_t m_cq_map_size    = 0UL;
+        io_uring_sqe* m_sqes    = nullptr;
+        size_t m_sqes_size      = 0UL;
+        unsigned* m_sq_tail     = nullptr;
+        unsigned* m_sq_array    = nullptr;
+        unsigned m_sq_mask      = 0U;
+        unsigned* m_cq_head     = nullptr;
+        unsigned* m_cq_tail     = nullptr;
+        unsigned m_cq_mask      = 0U;
+        io_uring_cqe* m_cqes    = nullptr;
+        unsigned m_entries      = 0U;
+        unsigned m_in_flight    = 0U;
+        //--------------------------
+        char* m_memory      = nullptr;
+        size_t m_capacity   = 0UL;
+        bool m_fixed        = false;
+        std::vector<Buffer> m_buffers;
+        size_t m_current    = 0UL;
+        uint64_t m_offset   = 0UL; // Where the next submitted buffer goes
+        std::chrono::steady_clock::time_point m_last_commit;
+        bool m_batching     = false;
+    //--------------------------------------------------------------
+}; // end class Logger::UringFileSink::Ring
+//--------------------------------------------------------------
+#else
+//--------------------------------------------------------------
+// **Built without io_uring: open() always sends the sink to the fallback**
+//--------------------------------------------------------------
+class Logger::UringFileSink::Ring {
+    //--------------------------------------------------------------
+    public:
+        //--------------------------------------------------------------
+        bool open(const std::string&, const UringFileSinkOptions&, const std::chrono::system_clock::time_point&) { return false; }
+        void append(std::string_view) {}
+        void poll(const std::chrono::steady_clock::time_point&) {}
+        void set_batching(const bool&) {}
+        void flush(void) {}
+        void write_pending(void) noexcept {}
+    //--------------------------------------------------------------
+}; // end class Logger::UringFileSink::Ring
+//--------------------------------------------------------------
+#endif
+//--------------------------------------------------------------
+Logger::UringFileSink::UringFileSink(std::string filename, const UringFileSinkOptions& options) : m_ring(std::make_unique<Ring>()) {
+    //--------------------------
+    const bool _rotation = options.file.max_size || options.file.rotation_interval.count() > 0;
+    //--------------------------
+    if (_rotation || !m_ring->open(filename, options, std::chrono::system_clock::now())) {
+        m_ring.reset();
+        m_fallback = std::make_unique<FileSink>(std::move(filename), options.file);
+    } // end if (_rotation || ...)
+    //--------------------------
+} // end Logger::UringFileSink::UringFileSink(std::string filename, const UringFileSinkOptions& options)
+//--------------------------------------------------------------
+Logger::UringFileSink::~UringFileSink(void) = default;
+//--------------------------------------------------------------
+void Logger::UringFileSink::write(const LogRecord& record, std::string_view formatted) {
+    //--------------------------
+    if (m_fallback) {
+        m_fallback->write(record, formatted);
+        return;
+    } // end if (m_fallback)
+    //--------------------------
+    m_ring->append(formatted);
+    m_ring->append("\n");
+    m_ring->poll(std::chrono::steady_clock::now());
+    //--------------------------
+} // end void Logger::UringFileSink::write(const LogRecord& record, std::string_view formatted)
+//--------------------------------------------------------------
+void Logger::UringFileSink::flush(void) {
+    //--------------------------
+    if (m_fallback) {
+        m_fallback->flush();
+    } else {
+        m_ring->flush();
+    } // end if (m_fallback)
+    //--------------------------
+} // end void Logger::UringFileSink::flush(void)
+//--------------------------------------------------------------
+void Logger::UringFileSink::poll(const std::chrono::steady_clock::time_point& now) {
+    //--------------------------
+    if (m_fallback) {
+        m_fallback->poll(now);
+    } else {
+        m_ring->poll(now);
+    } // end if (m_fallback)
+    //--------------------------
+} // end void Logger::UringFileSink::poll(const std::chrono::steady_clock::time_point& now)
+//--------------------------------------------------------------
+void Logger::UringFileSink::set_batching(const bool& enabled) {
+    //--------------------------
+    if (m_fallback) {
+        m_fallback->set_batching(enabled);
+    } else {
+        m_ring->set_batching(enabled);
+    } // end if (m_fallback)
+    //--------------------------
+} // end void Logger::UringFileSink::set_batching(const bool& enabled)
+//--------------------------------------------------------------
+void Logger::UringFileSink::write_pending(void) noexcept {
+    //--------------------------
+    if (m_fallback) {
+        m_fallback->write_pending();
+    } else {
+        m_ring->write_pending();
+    } // end if (m_fallback)
+    //--------------------------
+} // end void Logger::UringFileSink::write_pending(void) noexcept
+//--------------------------------------------------------------
+bool Logger::UringFileSink::is_uring(void) const {
+    return m_ring != nullptr;
+} // end bool Logger::UringFileSink::is_uring(void) const
+//--------------------------------------------------------------
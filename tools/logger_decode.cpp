@@ -0,0 +1,49 @@
+//--------------------------------------------------------------
+// Logger library
+//--------------------------------------------------------------
+#include "BinarySink.hpp"
+//--------------------------------------------------------------
+// Standard cpp library
+//--------------------------------------------------------------
+#include <iostream>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+//--------------------------------------------------------------
+// **Prints the text lines stored in BinarySink files**
+//--------------------------------------------------------------
+int main(int argc, char* argv[]) {
+    //--------------------------
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <binary log file>...\n";
+        return 1;
+    } // end if (argc < 2)
+    //--------------------------
+    int _status = 0;
+    std::string _line;
+    //--------------------------
+    for (int i = 1; i < argc; ++i) {
+        //--------------------------
+        std::ifstream _input(argv[i], std::ios::binary);
+        if (!_input) {
+            std::cerr << argv[i] << ": cannot open file\n";
+            _status = 1;
+            continue;
+        } // end if (!_input)
+        //--------------------------
+        Logger::BinaryDecoder _decoder(_input);
+        try {
+            while (_decoder.next(_line)) {
+                std::cout << _line << '\n';
+            } // end while (_decoder.next(_line))
+        } catch (const std::exception& e) {
+            std::cerr << argv[i] << ": " << e.what() << '\n';
+            _status = 1;
+        } // end try
+        //--------------------------
+    } // end for (int i = 1; i < argc; ++i)
+    //--------------------------
+    return _status;
+    //--------------------------
+} // end int main(int argc, char* argv[])
+//--------------------------------------------------------------